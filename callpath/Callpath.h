@@ -86,6 +86,11 @@ public:
   /// Number of elements in the callpath.
   size_t size() const;
 
+  /// Value that identifies this callpath uniquely within a process, e.g. for hashing.
+  uintptr_t id() const { 
+    return reinterpret_cast<uintptr_t>(path); 
+  }
+
   /// Writes this callpath out to a stream.
   void write_out(std::ostream& out);
 
@@ -33,24 +33,26 @@
 #define CALLPATH_RUNTIME_H
 
 #include <vector>
+#include <string>
 #include <stdint.h>
 #include "Callpath.h"
+#include "FrameId.h"
+#include "hash_cache.h"
 
-namespace Dyninst {
-  namespace Stackwalker {
-    class Walker;
-  }
-}
+class Unwinder;
 
 /// This class contains runtime support methods for Callpaths.
-/// It's the interface between our modules and DynStackwalker.
-/// Each of these contains a Walker for the process that 
-/// instantiated it.
+/// It's the interface between our modules and the stackwalker.
+/// Each of these contains an Unwinder for the process that 
+/// instantiated it, which is created on the first walk.
 class CallpathRuntime {
 public:
   /// Default constructor.
   CallpathRuntime();
 
+  /// Destructor.
+  ~CallpathRuntime();
+
   /// Returns a newly-traced callpath using this runtime's walker.
   Callpath doStackwalk(size_t wrap_level = 0);
     
@@ -60,13 +62,32 @@ public:
   /// Number of bad walks out of total.
   size_t badWalks();
 
+  /// Number of walks whose return addresses had been seen before, so that the 
+  /// callpath came straight out of the path cache.
+  size_t pathHits();
+
+  /// Number of walks that had to build a new callpath.
+  size_t pathMisses();
+
+  /// Number of return addresses resolved from the frame cache in path misses.
+  size_t frameHits();
+
+  /// Number of return addresses that needed a symbol lookup.
+  size_t frameMisses();
+
   /// Whether or not to chop off calls above __libc_start_main 
   /// when walking the stack.
   void set_chop_libc(bool chop);
 
+  /// Selects the unwinder backend by name; see Unwinder::create() for names.  
+  /// Must be called before the first walk.  Unknown names are reported and the 
+  /// default backend is used instead.
+  void set_unwinder(const std::string& name);
+
 private:
-  /// Used by doStackwalk
-  Dyninst::Stackwalker::Walker *walker;
+  /// Used by doStackwalk.  Created lazily, as some backends are expensive to set up.
+  Unwinder *unwinder;
+  std::string unwinder_name;  /// Name of backend to create.
 
   // These counters keep track of stats on how many
   // bad stackwalks we're getting.
@@ -76,6 +97,27 @@ private:
   // Keep track of address of __libc_start_main
   bool chop_libc_calls;
   uintptr_t libc_start_main_addr;
+
+  /// Return addresses from the last walk, after wrapping and libc calls are chopped.
+  std::vector<uintptr_t> addrs;
+
+  /// Memoized FrameIds for return addresses, so each one is only resolved once.
+  hash_cache<uintptr_t, FrameId, address_hash> frame_cache;
+
+  /// Memoized callpaths for sequences of return addresses.
+  hash_cache<std::vector<uintptr_t>, Callpath, address_vector_hash> path_cache;
+
+  size_t path_hits;     /// Walks answered by path_cache.
+  size_t path_misses;   /// Walks that missed path_cache.
+  size_t frame_hits;    /// Addresses answered by frame_cache.
+  size_t frame_misses;  /// Addresses that missed frame_cache.
+
+  /// Creates the unwinder if there isn't one yet.
+  void init_unwinder();
+
+  // Copying would share the unwinder.
+  CallpathRuntime(const CallpathRuntime&);
+  CallpathRuntime& operator=(const CallpathRuntime&);
 };
 
 #endif //CALLPATH_RUNTIME_H
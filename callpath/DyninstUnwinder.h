@@ -0,0 +1,66 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC.  
+// Produced at the Lawrence Livermore National Laboratory  
+// Written by Todd Gamblin, tgamblin@llnl.gov.
+// LLNL-CODE-417602
+// All rights reserved.  
+// 
+// This file is part of Libra. For details, see http://github.com/tgamblin/libra.
+// Please also read the LICENSE file for further information.
+// 
+// Redistribution and use in source and binary forms, with or without modification, are
+// permitted provided that the following conditions are met:
+// 
+//  * Redistributions of source code must retain the above copyright notice, this list of
+//    conditions and the disclaimer below.
+//  * Redistributions in binary form must reproduce the above copyright notice, this list of
+//    conditions and the disclaimer (as noted below) in the documentation and/or other materials
+//    provided with the distribution.
+//  * Neither the name of the LLNS/LLNL nor the names of its contributors may be used to endorse
+//    or promote products derived from this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+// OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+// LAWRENCE LIVERMORE NATIONAL SECURITY, LLC, THE U.S. DEPARTMENT OF ENERGY OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+// ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+/////////////////////////////////////////////////////////////////////////////////////////////////
+#ifndef DYNINST_UNWINDER_H
+#define DYNINST_UNWINDER_H
+
+#include <vector>
+#include <string>
+#include "Unwinder.h"
+
+#include "frame.h"
+
+namespace Dyninst {
+  namespace Stackwalker {
+    class Walker;
+  }
+}
+
+///
+/// Unwinder that uses a StackwalkerAPI Walker for the current process.  Walkers
+/// are expensive to create, so this is only constructed when it's first needed.
+///
+class DyninstUnwinder : public Unwinder {
+public:
+  DyninstUnwinder();
+  virtual ~DyninstUnwinder();
+
+  virtual bool walk(std::vector<uintptr_t>& addrs);
+  virtual bool lookup(size_t i, std::string& module, uintptr_t& offset);
+  virtual bool name(size_t i, std::string& name);
+  virtual bool can_name();
+
+private:
+  Dyninst::Stackwalker::Walker *walker;           /// Walker for this process.
+  std::vector<Dyninst::Stackwalker::Frame> swalk; /// Frames from the last walk, including walk()'s own.
+};
+
+#endif // DYNINST_UNWINDER_H
@@ -147,6 +147,11 @@ public:
     return *identifier;
   }
 
+  /// Value that identifies this UniqueId within a process, e.g. for hashing.
+  uintptr_t id() const {
+    return reinterpret_cast<uintptr_t>(identifier);
+  }
+
   void write_out(std::ostream& out) const {
     wavelet::vl_write(out, identifier->size());
     out.write(identifier->c_str(), identifier->size());
@@ -0,0 +1,74 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC.  
+// Produced at the Lawrence Livermore National Laboratory  
+// Written by Todd Gamblin, tgamblin@llnl.gov.
+// LLNL-CODE-417602
+// All rights reserved.  
+// 
+// This file is part of Libra. For details, see http://github.com/tgamblin/libra.
+// Please also read the LICENSE file for further information.
+// 
+// Redistribution and use in source and binary forms, with or without modification, are
+// permitted provided that the following conditions are met:
+// 
+//  * Redistributions of source code must retain the above copyright notice, this list of
+//    conditions and the disclaimer below.
+//  * Redistributions in binary form must reproduce the above copyright notice, this list of
+//    conditions and the disclaimer (as noted below) in the documentation and/or other materials
+//    provided with the distribution.
+//  * Neither the name of the LLNS/LLNL nor the names of its contributors may be used to endorse
+//    or promote products derived from this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+// OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+// LAWRENCE LIVERMORE NATIONAL SECURITY, LLC, THE U.S. DEPARTMENT OF ENERGY OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+// ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+/////////////////////////////////////////////////////////////////////////////////////////////////
+#ifndef UNWINDER_H
+#define UNWINDER_H
+
+#include <vector>
+#include <string>
+#include <stdint.h>
+
+///
+/// Interface for stackwalking backends used by CallpathRuntime.  A walk records the
+/// return addresses on the calling thread's stack, innermost first, starting with the
+/// function that called walk().  Frames of the last walk can then be resolved to 
+/// module/offset pairs, which must match across backends so that FrameIds do, too.
+///
+class Unwinder {
+public:
+  virtual ~Unwinder();
+
+  /// Replaces addrs with return addresses of the calling thread's stack.  
+  /// Returns false if the walk was incomplete.
+  virtual bool walk(std::vector<uintptr_t>& addrs) = 0;
+
+  /// Gets the module and the offset within it for frame i of the last walk.  
+  /// Returns false if the frame couldn't be resolved.
+  virtual bool lookup(size_t i, std::string& module, uintptr_t& offset) = 0;
+
+  /// Gets the name of the function for frame i of the last walk.
+  /// Returns false if the frame couldn't be named.
+  virtual bool name(size_t i, std::string& name) = 0;
+
+  /// Whether this backend can name frames at all.
+  virtual bool can_name() = 0;
+
+  /// Makes a new unwinder by name.  Names are "dyninst", for StackwalkerAPI, and 
+  /// "backtrace", for glibc's backtrace() and dl_iterate_phdr().  Returns NULL if 
+  /// there's no such backend in this build.
+  static Unwinder *create(const std::string& name);
+
+  /// Name of the backend to use if none is specified: dyninst if it's available,
+  /// backtrace if it isn't.
+  static const char *default_name();
+};
+
+#endif // UNWINDER_H
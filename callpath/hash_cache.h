@@ -0,0 +1,154 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC.  
+// Produced at the Lawrence Livermore National Laboratory  
+// Written by Todd Gamblin, tgamblin@llnl.gov.
+// LLNL-CODE-417602
+// All rights reserved.  
+// 
+// This file is part of Libra. For details, see http://github.com/tgamblin/libra.
+// Please also read the LICENSE file for further information.
+// 
+// Redistribution and use in source and binary forms, with or without modification, are
+// permitted provided that the following conditions are met:
+// 
+//  * Redistributions of source code must retain the above copyright notice, this list of
+//    conditions and the disclaimer below.
+//  * Redistributions in binary form must reproduce the above copyright notice, this list of
+//    conditions and the disclaimer (as noted below) in the documentation and/or other materials
+//    provided with the distribution.
+//  * Neither the name of the LLNS/LLNL nor the names of its contributors may be used to endorse
+//    or promote products derived from this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+// OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+// LAWRENCE LIVERMORE NATIONAL SECURITY, LLC, THE U.S. DEPARTMENT OF ENERGY OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+// ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+/////////////////////////////////////////////////////////////////////////////////////////////////
+#ifndef HASH_CACHE_H
+#define HASH_CACHE_H
+
+#include <stdint.h>
+#include <cstddef>
+#include <vector>
+#include <utility>
+
+///
+/// Home slot for hash h in an open-addressed table of mask + 1 slots, where that's a 
+/// power of two.  Mixes in high bits, since addresses and pointers have few low ones.
+/// hash_cache uses this, and so do other tables keyed on addresses.
+///
+inline size_t hash_slot(size_t h, size_t mask) {
+  h ^= h >> 16;
+  h *= 0x45d9f3b;
+  h ^= h >> 16;
+  return h & mask;
+}
+
+
+///
+/// Small open-addressed hash table for memoizing expensive lookups, like symbol
+/// resolution in CallpathRuntime.  Entries are only ever added, so values found
+/// stay valid until the next insert() or clear().
+///
+/// Hash must be a functor returning a size_t for a const Key&.  Key needs operator==.
+/// Neither Key nor Value needs a default constructor.
+///
+template <class Key, class Value, class Hash>
+class hash_cache {
+public:
+  hash_cache() : mask(0) { }
+  ~hash_cache() { }
+
+  /// Returns a pointer to the value cached for key, or NULL if there isn't one.
+  Value *find(const Key& key) {
+    if (entries.empty()) return NULL;
+
+    size_t h = hash(key);
+    for (size_t i = index(h); slots[i]; i = (i + 1) & mask) {
+      entry& e = entries[slots[i] - 1];
+      if (hashes[i] == h && e.first == key) return &e.second;
+    }
+    return NULL;
+  }
+
+  /// Adds a value for a key that isn't in the cache yet.  Returns a pointer to the 
+  /// cached value.
+  Value *insert(const Key& key, const Value& value) {
+    if (2 * (entries.size() + 1) > slots.size()) grow();
+
+    entries.push_back(entry(key, value));
+    place(hash(key), entries.size());
+    return &entries.back().second;
+  }
+
+  /// Number of entries in the cache.
+  size_t size() const { return entries.size(); }
+
+  /// Removes all entries.
+  void clear() {
+    entries.clear();
+    slots.clear();
+    hashes.clear();
+    mask = 0;
+  }
+
+private:
+  typedef std::pair<Key, Value> entry;
+
+  Hash hash;                    /// Hash functor for keys.
+  std::vector<entry> entries;   /// Cached keys and values, in insertion order.
+  std::vector<size_t> slots;    /// 1 + index into entries, or 0 for an empty slot.
+  std::vector<size_t> hashes;   /// Hash of the key in each occupied slot.
+  size_t mask;                  /// slots.size() - 1.  Slots are a power of two, at most half full.
+
+  /// Home slot for a hash.
+  size_t index(size_t h) const {
+    return hash_slot(h, mask);
+  }
+
+  /// Puts entry number n (1-based) with hash h into the first free slot for it.
+  void place(size_t h, size_t n) {
+    size_t i = index(h);
+    while (slots[i]) i = (i + 1) & mask;
+    slots[i] = n;
+    hashes[i] = h;
+  }
+
+  /// Doubles the number of slots and re-places all entries.
+  void grow() {
+    size_t new_size = slots.empty() ? 64 : 2 * slots.size();
+    slots.assign(new_size, 0);
+    hashes.assign(new_size, 0);
+    mask = new_size - 1;
+    for (size_t n=0; n < entries.size(); n++) {
+      place(hash(entries[n].first), n + 1);
+    }
+  }
+};
+
+
+/// Hash functor for addresses.  hash_cache mixes the bits, so this is just the address.
+struct address_hash {
+  size_t operator()(uintptr_t addr) const {
+    return addr;
+  }
+};
+
+
+/// Hash functor for sequences of addresses, e.g. return addresses from a stackwalk.
+struct address_vector_hash {
+  size_t operator()(const std::vector<uintptr_t>& addrs) const {
+    size_t h = addrs.size();
+    for (size_t i=0; i < addrs.size(); i++) {
+      h ^= addrs[i] + 0x9e3779b9 + (h << 6) + (h >> 2);
+    }
+    return h;
+  }
+};
+
+#endif // HASH_CACHE_H
@@ -0,0 +1,174 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC.  
+// Produced at the Lawrence Livermore National Laboratory  
+// Written by Todd Gamblin, tgamblin@llnl.gov.
+// LLNL-CODE-417602
+// All rights reserved.  
+// 
+// This file is part of Libra. For details, see http://github.com/tgamblin/libra.
+// Please also read the LICENSE file for further information.
+// 
+// Redistribution and use in source and binary forms, with or without modification, are
+// permitted provided that the following conditions are met:
+// 
+//  * Redistributions of source code must retain the above copyright notice, this list of
+//    conditions and the disclaimer below.
+//  * Redistributions in binary form must reproduce the above copyright notice, this list of
+//    conditions and the disclaimer (as noted below) in the documentation and/or other materials
+//    provided with the distribution.
+//  * Neither the name of the LLNS/LLNL nor the names of its contributors may be used to endorse
+//    or promote products derived from this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+// OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+// LAWRENCE LIVERMORE NATIONAL SECURITY, LLC, THE U.S. DEPARTMENT OF ENERGY OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+// ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+/////////////////////////////////////////////////////////////////////////////////////////////////
+#ifndef EFFORT_CONTAINER_H
+#define EFFORT_CONTAINER_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <map>
+#include <istream>
+#include <streambuf>
+
+#include "libra-config.h"
+#ifdef LIBRA_HAVE_MPI
+#include <mpi.h>
+#endif // LIBRA_HAVE_MPI
+
+///\file effort_container.h
+///
+/// Compressed effort data can go in one file per region, or in a single container file
+/// per run.  A container holds the same bytes as the region files would, so readers 
+/// decode them the same way.  The format is:
+///
+///   "LIBRAEFC"                           8-byte magic number
+///   sections, one per call to parallel_compressor::compress():
+///     data bytes, directory bytes        8 bytes each, little-endian
+///     data                               region data, back to back
+///     directory                          vl count, then for each region:
+///                                        vl name length, name, vl offset in data, vl size
+///
+/// Windowed runs append a section per window.  A region's data is the concatenation of
+/// its pieces in all sections, just like appends to a region file.  The section header
+/// is written last, so a section with zero sizes is incomplete and is ignored.  Appends
+/// mark an incomplete section with its data size and no directory, so that readers can
+/// skip it and read the sections after it.
+///
+namespace effort {
+
+  /// Input stream over bytes in memory, e.g. in a mapped file.  Bytes aren't copied.
+  class memory_istream : public std::istream {
+  public:
+    memory_istream(const char *data, size_t size);
+
+  private:
+    struct memory_buf : public std::streambuf {
+      void set(const char *data, size_t size) {
+        char *begin = const_cast<char*>(data);
+        setg(begin, begin, begin + size);
+      }
+    };
+    memory_buf buf;
+  };
+
+
+  ///
+  /// Reader for compressed effort data.  This takes either a container file, or a 
+  /// directory that holds either a container or one file per region.  Containers are
+  /// mapped into memory, and regions are read straight out of the mapping.
+  ///
+  class effort_container {
+  public:
+    /// Name of the container file in an output directory.
+    static const char *FILENAME;
+
+    /// Path of the container file in directory dir.
+    static std::string path(const std::string& dir);
+
+    /// True if filename is a container file.
+    static bool is_container(const std::string& filename);
+
+    /// Opens a container file, or a directory of effort data.  Exits with an error if
+    /// it can't be read.
+    effort_container(const std::string& path);
+
+    /// Unmaps the container, if there is one.
+    ~effort_container();
+
+    /// Names of regions in the container, in order of first appearance, or names of 
+    /// region files in the directory.
+    const std::vector<std::string>& names() const { return region_names; }
+
+    /// Opens a stream over the data for region name: the same bytes as its region 
+    /// file.  Caller must delete the stream.  Returns NULL if there's no such region.
+    std::istream *open_region(const std::string& name) const;
+
+    /// Whether regions come from a container file rather than separate files.
+    bool mapped() const { return map_base != NULL; }
+
+  private:
+    typedef std::pair<const char*, size_t> piece;
+    
+    std::string dir;                        /// Directory for region files.
+    std::vector<std::string> region_names;  /// All regions available.
+    std::map<std::string, std::vector<piece> > pieces;  /// Pieces of each region's data.
+    char *map_base;                         /// Mapped container, or NULL.
+    size_t map_size;                        /// Size of mapping.
+
+    /// Maps a container file and reads its directories.  Returns false on error.
+    bool map_container(const std::string& filename);
+
+    // not copyable.
+    effort_container(const effort_container&);
+    effort_container& operator=(const effort_container&);
+  };
+
+
+#ifdef LIBRA_HAVE_MPI
+  ///
+  /// Writes a container collectively with MPI-IO.  Each call to write() puts one region
+  /// from each process that has one at the next offsets in the file, so a round of 
+  /// regions goes out in a single collective write.  All calls are collective over comm.
+  ///
+  class container_writer {
+  public:
+    /// Opens the container at filename.  If append is set, a new section is added after
+    /// the existing ones.  Otherwise the file is replaced.
+    container_writer(const std::string& filename, bool append, MPI_Comm comm);
+
+    /// Closes the container if close() wasn't called.
+    ~container_writer();
+
+    /// Writes data for region name.  Processes with nothing to write pass empty names.
+    void write(const std::string& name, const std::string& data);
+
+    /// Writes the directory and section header, and closes the file.
+    void close();
+
+  private:
+    MPI_Comm comm;
+    MPI_File file;
+    bool open;
+    uint64_t section_start;   /// Offset of this section's header.
+    uint64_t data_bytes;      /// Bytes of region data written so far.
+    uint64_t entries;         /// Directory entries so far (on rank 0).
+    std::string directory;    /// Directory entries so far (on rank 0).
+
+    /// Offset where a new section goes.  Marks an unfinished last section so that 
+    /// readers skip it.  Called on rank 0 only.
+    MPI_Offset end_of_sections();
+  };
+#endif // LIBRA_HAVE_MPI
+
+} // namespace
+
+#endif // EFFORT_CONTAINER_H
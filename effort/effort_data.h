@@ -34,27 +34,101 @@
 
 #include <stdint.h>
 #include <map>
+#include <vector>
 #include <string>
 #include <ostream>
 #include "effort_key.h"
 #include "effort_record.h"
+#include "hash_cache.h"
 #include "ezw.h"
 
 namespace effort {
 
   typedef std::map<effort_key, effort_record> effort_map;
 
+
+  ///
+  /// Open-addressed hash table from effort keys to entries in an effort_map.  Keys 
+  /// hash on their interned metric and callpath pointers, so a lookup is a couple of
+  /// probes into one flat array instead of a descent through the map.  The last entry
+  /// found is memoized, since the same region usually comes up many times in a row.
+  /// 
+  /// This is a cache: it doesn't own entries, and copies start out empty.
+  ///
+  class region_table {
+  public:
+    typedef effort_map::value_type entry_t;
+
+    region_table() : count(0), last(NULL) { }
+    region_table(const region_table& other) : count(0), last(NULL) { }
+    region_table& operator=(const region_table& other) { clear(); return *this; }
+    ~region_table() { }
+
+    /// Finds the entry for a key with the supplied hash, or returns NULL.
+    entry_t *find(const effort_key& key, size_t hash) {
+      if (last && last->first == key) return last;
+      if (!count) return NULL;
+
+      const size_t mask = slots.size() - 1;
+      for (size_t i = index(hash); slots[i].entry; i = (i + 1) & mask) {
+        if (slots[i].hash == hash && slots[i].entry->first == key) {
+          return (last = slots[i].entry);
+        }
+      }
+      return NULL;
+    }
+
+    /// Adds an entry that isn't in the table yet.
+    void insert(entry_t *entry, size_t hash);
+
+    /// Removes an entry, if it's in the table.
+    void remove(entry_t *entry, size_t hash);
+
+    /// Removes all entries.
+    void clear();
+
+    /// Number of entries in the table.
+    size_t size() const { return count; }
+
+  private:
+    struct slot {
+      size_t hash;        /// Hash of entry's key, checked before comparing keys.
+      entry_t *entry;     /// Entry in the map, or NULL if the slot is free.
+      slot() : hash(0), entry(NULL) { }
+    };
+
+    std::vector<slot> slots;  /// Power-of-two sized array of slots, at most half full.
+    size_t count;             /// Number of occupied slots.
+    entry_t *last;            /// Last entry found.
+
+    /// Home slot for a hash.
+    size_t index(size_t hash) const {
+      return hash_slot(hash, slots.size() - 1);
+    }
+
+    /// Doubles the number of slots and rehashes.
+    void grow();
+  };
+
+
   ///
   /// This is the central bookkeeping structure for the effort module.
   /// Maps effort keys to effort_records and keeps track of how many progress
-  /// steps have happened so far.
+  /// steps have happened so far.  Values for all records are kept in one 
+  /// effort_store, with a row for each record.
+  ///
+  /// The store only holds values for the current window of progress steps, which
+  /// starts at window_start.  Unless start_window() is called, this is all steps.
   ///
   struct effort_data {
   public:
     typedef effort_map::iterator iterator;
 
     effort_map emap;          /// Recorded effort values within the map
+    effort_store store;       /// Values of all records for committed progress steps.
+    region_table table;       /// Fast lookup for entries in emap.
     size_t progress_count;    /// Number or progress steps so far.
+    size_t window_start;      /// First progress step with values in the store.
 
     /// Constructor just inits progress count to zero.
     effort_data();
@@ -62,13 +136,31 @@ namespace effort {
     /// Destructor
     ~effort_data() { }
 
-    /// Calls commit on each effort record and increments the current progress count.
+    /// Commits current effort of each record and increments the current progress count.
     /// If progress_count is provided, pads effort values with zeros up to the 
     /// specified progress step.
     void progress_step(size_t step_to = 0);
 
+    /// Gets the record for a key, adding one that starts at the current progress 
+    /// step if there isn't one.  This is on the hot path for every intercepted call,
+    /// so it checks the region table before falling back to the map.
     effort_record& operator[](const effort_key& key) {
-      return emap[key];
+      size_t hash = key.hash();
+      region_table::entry_t *entry = table.find(key, hash);
+      if (!entry) entry = add(key, hash);
+      return entry->second;
+    }
+
+    /// Adds a record for key whose values are zero for all steps so far, if there 
+    /// isn't one already.
+    void insert(const effort_key& key) {
+      (*this)[key].start = 0;
+    }
+
+    /// Values of a record for progress steps in the current window, contiguous in memory.
+    /// This pointer is invalidated when records are added or progress steps taken.
+    double *values(const effort_record& record) { 
+      return store.row(record.id); 
     }
 
     effort_data::iterator begin() { return emap.begin(); }
@@ -76,10 +168,27 @@ namespace effort {
     size_t size() { return emap.size(); }
     size_t steps() { return progress_count; }
 
+    /// Number of progress steps in the current window.
+    size_t window_steps() { return progress_count - window_start; }
+
+    /// Discards values for the current window and starts a new one at the current
+    /// progress step.  Records are kept, so regions keep their rows in the store.
+    void start_window() {
+      store.clear_values();
+      window_start = progress_count;
+    }
+
     bool contains(const effort_key& key) {
-      return emap.find(key) != emap.end();
+      return table.find(key, key.hash()) || emap.find(key) != emap.end();
+    }
+
+    /// Removes a record.  Its values stay in the store, but are no longer used.
+    void erase(iterator i) {
+      table.remove(&*i, i->first.hash());
+      emap.erase(i);
     }
-    void clear() { emap.clear(); }
+
+    void clear() { table.clear(); emap.clear(); store.clear(); window_start = progress_count; }
     
     /// Writes keys and values for current progress step
     void write_current_step(std::ostream& out);
@@ -92,16 +201,9 @@ namespace effort {
                           std::map<effort_key, std::string> *filenames = NULL);
 
   private:
-
-    /// Functor for invoking commit on an effort record.
-    struct committer {
-      size_t count;
-      committer(size_t c) : count(c) { }
-      void operator()(effort_map::value_type& p) {
-        p.second.commit(count);
-      }
-    };
-
+    /// Slow path for operator[]: finds or creates the map entry for a key that's 
+    /// not in the table, and puts it in the table.
+    region_table::entry_t *add(const effort_key& key, size_t hash);
 
     /// Functor for writing out current step from effort_map
     struct write_current {
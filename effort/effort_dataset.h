@@ -33,6 +33,7 @@
 #define EFFORT_DATA_SET_H
 
 #include <string>
+#include <istream>
 #include <map>
 #include <vector>
 #include <string>
@@ -45,11 +46,16 @@ namespace effort {
 
   struct region {
     region(const std::string& filename, int approximation_level=-1, size_t pass_limit=0);
+    region(std::istream& in, int approximation_level=-1, size_t pass_limit=0);
     ~region();
     
     effort_key key;
     wavelet::ezw_header header;
     wavelet::wt_matrix mat;
+
+  private:
+    /// Reads key, header, and data from a stream of compressed effort data.
+    void read(std::istream& in, int approximation_level, size_t pass_limit);
   }; // region
 
 
@@ -32,6 +32,7 @@
 #ifndef EFFORT_KEY_H
 #define EFFORT_KEY_H
 
+#include <stdint.h>
 #include "Callpath.h"
 #include "Metric.h"
 #include "ModuleId.h"
@@ -72,6 +73,21 @@ namespace effort {
     /// True if the effort key represents communciation.
     bool isComm() const;
 
+    /// Hash of the interned metric and callpaths in this key.  Like the fast 
+    /// comparison operators, this is only consistent within a process.
+    size_t hash() const {
+      size_t h = metric.id();
+      h ^= type              + 0x9e3779b9 + (h << 6) + (h >> 2);
+      h ^= start_path.id()   + 0x9e3779b9 + (h << 6) + (h >> 2);
+      h ^= end_path.id()     + 0x9e3779b9 + (h << 6) + (h >> 2);
+      return h;
+    }
+
+    /// 64-bit hash of the contents of this key: metric name, type, and the module 
+    /// names and offsets of its callpaths.  Unlike hash(), this is the same on all
+    /// processes, so processes can compare keys without sending them.
+    uint64_t fingerprint() const;
+
     /// Writes out this effort id to a stream
     void write_out(std::ostream& out);
     
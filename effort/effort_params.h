@@ -38,6 +38,7 @@
 #include "effort_key.h"
 #include "env_config.h"
 #include "Metric.h"
+#include "Unwinder.h"
 
 /// TODO: make it so char*'s in here don't leak.
 
@@ -47,23 +48,41 @@ namespace effort {
   /// and their default values.
   struct effort_params {
     int rows_per_process;     /// # of rows consolidated to each compressor process
-    bool verify;              /// Whether or not to dump exact data.
+    int pipeline_depth;       /// # of batches of regions being aggregated at once, so that later batches 
+                              /// travel while earlier ones are compressed.  1 disables pipelining.
+    bool verify;              /// Whether to write losslessly coded exact data too.
+    bool container;           /// Whether to write all compressed regions into one container file per run
+                              /// with collective MPI-IO, instead of one file per region.
     int pass_limit;           /// Limit on number of EZW passes output (compression level)
     long long scale;          /// Scaling factor for double-precision numbers input to EZW coder.
+    bool single_precision;    /// Whether to aggregate, transform, and quantize regions as floats, which halves
+                              /// message volume and memory.  Plenty for timings at the default scale.
     bool sequential;          /// Whether EZW bit-ordering is per sequential algorithm.  Very slow!
-    const char *encoding;     /// Encoding to use.  Options are "rle", "arithmetic", "huffman", "none"
+    const char *encoding;     /// Encoding to use.  Options are "rle", "arithmetic", "huffman", "range", "none"
+    const char *filter;       /// Wavelet to transform with.  Options are "cdf97", "cdf53", "haar", or "auto",
+                              /// which picks the one likely to compress each region best.  "int53" is
+                              /// only used internally for exact output with verify; compression is skipped
+                              /// with a warning if it is set here.
+    int block_index;          /// Max entries in the per-file index of EZW blocks, which lets decoders
+                              /// decode blocks concurrently.  0 leaves the index out.
+    bool segmented;           /// Whether to code each EZW pass separately, so that readers can decode
+                              /// fewer passes, or only some blocks, without decoding everything.
 
     const char *metrics;      /// Comma-separated list of all metrics to monitor.  Possible values are 
                               /// PAPI metric names or "time".  This is a string.  Access metrics as 'Metric' objects
                               /// through get_metrics() below.
 
     bool chop_libc;           /// Whether to chop libc_start_main calls
+    const char *unwinder;     /// Stackwalking backend.  Can be dyninst or backtrace.  Defaults to dyninst if
+                              /// it's available.  backtrace is much cheaper to start up and to walk with.
     const char *regions;      /// Controls how to delineate effort regions in the code.  Can be effort, comm, or both.
     long long sampling;       /// Sampling rate for progress steps.  Defaults to 1.  If set higher, only rolls over 
                               /// progress every so many actual timesteps.
 
     bool topo;                /// alternately outputs topology-ordered compressed data.
     bool dump_keys;           /// Dump all effort keys to a file in MPI_Finalize.  Default is false.
+    int window;               /// If nonzero, compress every window progress steps during the run and free
+                              /// the raw values, instead of keeping everything until MPI_Finalize.
 
     bool ampl;                /// AMPL mode -- uses AMPL for sampling and outputs sampled trace.
     double confidence;        /// AMPL confidence
@@ -80,17 +99,25 @@ namespace effort {
     /// Constructor with default values of all parameters.
     effort_params() 
       : rows_per_process(32), 
+        pipeline_depth(2),
         verify(0), 
+        container(false),
         pass_limit(5), 
         scale(1 << 10), 
+        single_precision(false),
         sequential(0), 
         encoding("huffman"), 
+        filter("cdf97"),
+        block_index(64),
+        segmented(false),
         metrics("time"),
         chop_libc(false),
+        unwinder(Unwinder::default_name()),
         regions("effort"),
         sampling(1),
         topo(false),
         dump_keys(false),
+        window(0),
         ampl(false),
         confidence(.90),
         error(.08),
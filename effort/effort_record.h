@@ -32,42 +32,78 @@
 #ifndef EFFORT_RECORD_H
 #define EFFORT_RECORD_H
 
+#include <cstddef>
 #include <vector>
 
 namespace effort {
   
   /// An effort record keeps track of the value of one particular type of effort
   /// over all timesteps.  These are stored in a map and indexed by effort_keys.
+  /// Values for committed progress steps live in an effort_store, in the row given
+  /// by the record's id.
   struct effort_record {
     double current;         /// Current value of this type of effort.
-    std::vector<double> values;  /// Effort values indexed by progress step
+    size_t id;              /// Row of this record's values in the effort_store.
+    size_t start;           /// Progress step this record started at.  Earlier values are zero.
 
-    /// Constructs an emty effort record
-    effort_record() : current(0) { }
-    
-    /// Constructs an effort record with all values zero
-    effort_record(int size) : current(0), values(size, 0) { }
+    /// Constructs an effort record whose values start at progress step s.
+    effort_record(size_t i = 0, size_t s = 0) : current(0), id(i), start(s) { }
     
     /// Destructor
     ~effort_record() { }
     
-    /// Pushes current effort on back of values, resets current effort to zero.
-    void commit(size_t progress_count);
-    
-    /// Gets the effort for a particular progress step.
-    double& operator[](int p) { return values[p]; }
-
-    /// Gets the size so far.
-    size_t size() { return values.size(); }
-    
-    
-    /// Gets the values.begin()
-    std::vector<double>::iterator begin() { return values.begin(); }
-
     /// Adds to current value of this effort.
     void operator+=(double value) { current += value; }
   };
   
+
+  /// Columnar storage for values of all effort records.  This is one contiguous
+  /// buffer with a row per record and a column per progress step, so each record's 
+  /// values are contiguous and can be handed to MPI directly.  Rows and columns grow
+  /// in chunks, and growing never moves less than a whole chunk, so commits are 
+  /// amortized O(1) and there is no per-record allocation.  
+  /// Unwritten values are always zero.
+  class effort_store {
+  public:
+    /// Constructs an empty store.
+    effort_store();
+
+    /// Destructor
+    ~effort_store() { }
+
+    /// Adds a row of zeros and returns its id.
+    size_t add_row();
+
+    /// Makes room for values up to (but not including) progress step steps.
+    void reserve_steps(size_t steps) {
+      if (steps > stride) grow_steps(steps);
+    }
+
+    /// Pointer to first value of a row.  Values for each row are contiguous, but
+    /// this may be invalidated by add_row() or reserve_steps().
+    double *row(size_t id) { return &buffer[id * stride]; }
+
+    /// Value for a particular row and step.  Step must have been reserved.
+    double& operator()(size_t id, size_t step) { return buffer[id * stride + step]; }
+
+    /// Number of rows added so far.
+    size_t rows() const { return num_rows; }
+
+    /// Removes all rows.
+    void clear();
+
+    /// Zeroes all values, but keeps rows and the space reserved for them.
+    void clear_values();
+
+  private:
+    std::vector<double> buffer;   /// Values, row-major, stride values per row.
+    size_t stride;                /// Steps allocated per row.
+    size_t num_rows;              /// Rows in use.
+    size_t row_capacity;          /// Rows allocated.
+
+    /// Re-lays out buffer with room for at least steps steps per row.
+    void grow_steps(size_t steps);
+  };
   
 } // namespace
 
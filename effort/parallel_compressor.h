@@ -48,9 +48,18 @@ namespace effort {
     parallel_compressor(const effort_params& params);
 
     /// Distributes work to subcommunicators and delegates to do_compress() to do the
-    /// actual encoding.
+    /// actual encoding.  Only the current window of effort_log is compressed.
     void compress(effort_data& effort_log, MPI_Comm comm_world);
 
+    /// In windowed mode, each call to compress() appends the current window of the
+    /// effort log to a stream file per region, instead of writing new files.  Regions
+    /// keep their file ids across calls, and files for regions that first appear in 
+    /// later windows hold only those windows.  Exact data isn't written in this mode.
+    /// With params.container, each window is a section appended to the container.
+    void set_windowed(bool w) {
+      windowed = w;
+    }
+
     /// Sets directory to output compressed data to
     void set_output_dir(const std::string& dir) { 
       output_dir = dir;
@@ -75,14 +84,45 @@ namespace effort {
 
   private:
     /// Helper for distribute_work().  Actually does the work of compression on a subcommunicator
-    void do_compression(wavelet::wt_matrix& mat, effort_key key, int id, MPI_Comm comm);
-    
+    /// If append is set, the encoded data is appended to an existing stream file.
+    /// If encoded is non-null, the root puts the encoded data there instead of in a file.
+    /// T is float with params.single_precision, and double otherwise.
+    template <class T>
+    void do_compression(boost::numeric::ublas::matrix<T>& mat, effort_key key, int id, bool append, 
+                        MPI_Comm comm, std::string *encoded = NULL);
+
+    /// Wavelet to transform a region with, given this process's rows of it in mat.  This
+    /// is params.filter, or for "auto", the wavelet whose row transforms leave the 
+    /// fewest significant bits over all of comm.  Collective on comm.
+    template <class T>
+    wavelet::filter_t choose_filter(boost::numeric::ublas::matrix<T>& mat, MPI_Comm comm);
+
+    /// Name of the file (or container entry) for the region with key and file id.
+    std::string region_filename(const effort_key& key, int id);
+
+    /// Assigns regions (indices into keys) to m sets of processes, balancing estimated
+    /// compression cost with longest-processing-time-first scheduling.  Each set's
+    /// regions are listed costliest first.  Collective on comm; all processes get
+    /// the same assignment.
+    void assign_regions(effort_data& effort_log, const std::vector<effort_key>& keys, int m,
+                        std::vector< std::vector<size_t> >& assigned, MPI_Comm comm);
+
+    /// Rough relative cost of encoding a region, given the largest magnitude and the
+    /// standard deviation of its values over all processes.  This is one for the
+    /// transform plus the number of EZW passes expected to find many significant
+    /// coefficients.
+    double estimate_cost(double max_abs, double stddev);
+
 
     const effort_params& params;
     std::string output_dir;
     std::string exact_dir;
     const std::map<effort_key, std::string> *file_map;
     Timer timer;   // keeps stats on timings of compression phases
+    size_t data_steps;   // progress steps in the log before padding
+    bool windowed;       // whether to append windows to stream files.
+    std::map<effort_key, size_t> stream_ids;  // file ids of regions, kept across windows.
+    bool container_started;   // whether a container has been written for this run.
 
     bool sample_topology;
   };
@@ -33,13 +33,20 @@
 #define PARALLEL_DECOMPRESSOR_H
 
 #include <string>
+#include <memory>
 #include "wavelet.h"
 #include "effort_params.h"
 #include "effort_data.h"
+#include "effort_container.h"
 #include "Timer.h"
 
 namespace effort {
 
+  /// Files may hold several windows of progress steps, appended one after another by a
+  /// windowed parallel_compressor.  Windows are stitched back together here.  Regions that
+  /// first appeared in a later window only have files for the last windows, so their 
+  /// values are aligned with the end of the run and are zero before that.
+  ///
   /// NOTE: This isn't as scalable as parallel_compressor because the EZW decoding
   ///       is not done in parallel.  However, this is only used for validating 
   ///       compression on pre-recorded data right now, so we don't need the same kind
@@ -76,11 +83,21 @@ namespace effort {
 
   private:
     /// Helper for distribute_work().  Actually does the work of compression on a subcommunicator
-    void do_decompression(wavelet::wt_matrix& mat, effort_key key, const std::string& file, MPI_Comm comm);
+    /// steps is the number of progress steps in the whole run.
+    void do_decompression(wavelet::wt_matrix& mat, effort_key key, const std::string& name, 
+                          size_t steps, MPI_Comm comm);
+
+    /// Compressed data in input_dir, opened on first use so that only processes that
+    /// read anything touch the file system.
+    const effort_container& input();
+
+    /// Opens the stream for a region in input_dir, or exits with an error.
+    std::istream *open_region(const std::string& name);
 
     size_t blocks;    // blocks used in last decoded file.
     std::string input_dir;
     std::map<effort_key, std::string> file_for_key;
+    std::auto_ptr<effort_container> container;   // compressed data in input_dir.
   };
 
 } //namespace
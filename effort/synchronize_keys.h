@@ -33,6 +33,9 @@
 #define SYNCHRONIZE_EFFORT_KEYS_H
 
 #include <mpi.h>
+#include <stdint.h>
+#include <vector>
+#include <utility>
 #include "effort_data.h"
 
 ///\file synchronize_keys.h
@@ -46,14 +49,23 @@
 /// 
 namespace effort {
 
+  /// Keys of an effort log paired with their fingerprints, sorted by fingerprint.
+  /// Pointers are to keys in the log's map.
+  typedef std::vector< std::pair<uint64_t, const effort_key*> > key_index;
+
+  /// Builds a key index for all keys in the supplied effort log.
+  void build_key_index(effort_data& effort_log, key_index& index);
+
   /// Receives a set of keys from another processor via PMPI and
-  /// Merges all of them into the supplied effort map.
-  void receive_keys(effort_data& effort_log, int src, MPI_Comm comm);
+  /// Merges all of them into the supplied effort map.  If index is provided,
+  /// keys that were new to the log are added to it.
+  void receive_keys(effort_data& effort_log, int src, MPI_Comm comm, key_index *index = NULL);
   
   /// Sends a set of effort_keys to another processor via PMPI.
-  void send_keys(effort_data& effort_log, int dest, MPI_Comm comm);
+  void send_keys(const std::vector<const effort_key*>& keys, int dest, MPI_Comm comm);
   
-  /// Reduces effort keys so that all processors have the same keys.
+  /// Reduces effort keys so that all processors have the same keys.  Processes
+  /// exchange key fingerprints, and only send keys that the receiver lacks.
   void synchronize_effort_keys(effort_data& effort_log, MPI_Comm comm);
   
 } // namespace
@@ -67,6 +67,11 @@ namespace wavelet {
 
     /// Returns next bit from stream in the lowest bit of the result.
     virtual unsigned get_bit();
+
+    /// Decodes size bytes into buffer, assembling each byte in a register instead of 
+    /// going through another bitstream.  Stops early if input runs out, so compare 
+    /// get_in_bytes() to size to check that it was all there.
+    virtual void read(unsigned char *buffer, size_t size);
     
     /// True if input is still avaialble.
     virtual bool good();
@@ -33,28 +33,32 @@
 #define BUFFERED_IBITSTREAM_H
 
 #include <istream>
+#include <stdint.h>
 #include "ibitstream.h"
 #include "buffered_obitstream.h"
 
 namespace wavelet {
 
-  // Class for reading individual bits at a time from an input stream.
-  // 
-  // TODO: buffer input.
-  // TOOD: support reading large numbers of bits at a time.
+  /// Class for reading individual bits at a time from an input stream.  Like 
+  /// vector_ibitstream, bits are loaded into a 64-bit word a word at a time.
   class buffered_ibitstream : public ibitstream {
   protected:
     std::istream& in;                /// input stream to read bits from.
 
     std::vector<unsigned char> buf;  /// Buffer or input characters
-    size_t pos;                      /// Position in buffer to read next byte
-    unsigned char mask;              /// Mask of next bit to read.
+    size_t pos;                      /// Position in buffer of next byte to load.
     size_t end;                      /// End of buffer in memory (1 past last byte)
+    uint64_t acc;                    /// Loaded bits not yet read, starting at the high bit.
+    size_t avail;                    /// Number of bits in acc.
 
     bool eof;       /// EOF flag
     
     /// Buffers data from underlying stream for reading and resets pointer
     virtual void reload();
+
+    /// Loads up to a word of input into the accumulator, reloading the buffer if 
+    /// necessary.  Loads nothing at the end of input.
+    void refill();
     
   public:
     /// Constructs an buffered_ibitstream to read from the prvided input stream.
@@ -65,25 +69,18 @@ namespace wavelet {
     virtual ~buffered_ibitstream();
 
     /// Gets a single bit of input.  Left in header to enable inlining.
-    unsigned get_bit() {
-      if (pos == end) {
-	reload();
-      }
-
-      unsigned bit = (mask & buf[pos]) ? 1 : 0;
-      mask >>= 1;
-
-      if (mask == 0) {
-	pos++;
-	mask = 0x80;
-      }
+    virtual unsigned get_bit() {
+      if (!avail) refill();
 
+      const unsigned bit = (unsigned)(acc >> 63);
+      acc <<= 1;
+      if (avail) avail--;
       return bit;
     }
 
     /// True if there are more bits to be input.
     virtual bool good() {
-      return !(pos == end && eof);
+      return avail || !(pos == end && eof);
     }
 
     virtual size_t get_in_bytes() {
@@ -35,19 +35,27 @@
 #include <iostream>
 #include <vector>
 #include <ostream>
+#include <stdint.h>
 #include "obitstream.h"
 
 namespace wavelet {
 
+  /// Output bit stream that buffers bits and writes them to an ostream.  Like 
+  /// vector_obitstream, bits are accumulated in a 64-bit word and buffered a word at
+  /// a time.
   class buffered_obitstream : public obitstream {
   protected:
     std::vector<unsigned char> buf;  /// Buffer for as yet unwritten data
-    size_t pos;                      /// Current write index in buffer.
-    unsigned char mask;              /// Mask of next bit to write.
+    size_t pos;                      /// Index in buf where bits in acc go.
+    uint64_t acc;                    /// Bits not yet stored in buf, starting at the high bit.
+    size_t acc_bits;                 /// Number of bits in acc.
     size_t bits;                     /// Total bits written out.
     
     std::ostream& out;               /// Underlying destination for all data.
     
+    /// Stores a full accumulator in buf and empties it, writing out buf if it's full.
+    void put_word();
+
     /// Puts all bits on internal buffer onto the output stream.
     /// Doesn't flush the output stream.  WILL write out trailing bits in
     /// last byte of buffer.
@@ -62,10 +70,27 @@ namespace wavelet {
     virtual ~buffered_obitstream();
 
     /// Puts a zero at the end of output.
-    virtual void put_zero();
+    virtual void put_zero() {
+      bits++;
+      if (++acc_bits == 64) put_word();
+    }
 
     /// Puts a one at the end of output.
-    virtual void put_one();
+    virtual void put_one() {
+      acc |= ((uint64_t)1 << (63 - acc_bits));
+      buffered_obitstream::put_zero();
+    }
+
+    /// Puts a bit without branching on it.
+    virtual void put_bit(bool bit) {
+      acc |= ((uint64_t)bit << (63 - acc_bits));
+      buffered_obitstream::put_zero();
+    }
+
+    /// Contexts don't matter for raw bits, so this just puts the bit.
+    virtual void put_context_bit(bool bit, size_t context) {
+      buffered_obitstream::put_bit(bit);
+    }
 
     /// Appends nbits bits from buf to the stream.  Optionally, the bits
     /// can be taken starting from an offset (0-7) within buf.
@@ -0,0 +1,62 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC.  
+// Produced at the Lawrence Livermore National Laboratory  
+// Written by Todd Gamblin, tgamblin@llnl.gov.
+// LLNL-CODE-417602
+// All rights reserved.  
+// 
+// This file is part of Libra. For details, see http://github.com/tgamblin/libra.
+// Please also read the LICENSE file for further information.
+// 
+// Redistribution and use in source and binary forms, with or without modification, are
+// permitted provided that the following conditions are met:
+// 
+//  * Redistributions of source code must retain the above copyright notice, this list of
+//    conditions and the disclaimer below.
+//  * Redistributions in binary form must reproduce the above copyright notice, this list of
+//    conditions and the disclaimer (as noted below) in the documentation and/or other materials
+//    provided with the distribution.
+//  * Neither the name of the LLNS/LLNL nor the names of its contributors may be used to endorse
+//    or promote products derived from this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+// OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+// LAWRENCE LIVERMORE NATIONAL SECURITY, LLC, THE U.S. DEPARTMENT OF ENERGY OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+// ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+/////////////////////////////////////////////////////////////////////////////////////////////////
+#ifndef WT_CANONICAL_HUFFMAN_H
+#define WT_CANONICAL_HUFFMAN_H
+
+#include <cstdlib>
+
+///
+/// Canonical huffman coding for RLE-coded ezw data.  Only code lengths are stored
+/// with the data, and codes are assigned from them in (length, symbol) order, so the
+/// decoder can build a lookup table and decode up to CANONICAL_TABLE_BITS bits at once
+/// instead of walking a tree a bit at a time.  Codes are limited to 15 bits.
+///
+namespace wavelet {
+
+  /// Codes up to this long are decoded with a single table lookup.
+  const int CANONICAL_TABLE_BITS = 11;
+
+  /// Upper bound on the size of canonical_huffman_compress() output for insize bytes.
+  size_t canonical_huffman_bound(size_t insize);
+
+  /// Codes insize bytes of in into out, which must have room for 
+  /// canonical_huffman_bound(insize) bytes.  Returns the size of the coded data.
+  size_t canonical_huffman_compress(const unsigned char *in, size_t insize, unsigned char *out);
+
+  /// Decodes outsize bytes from insize bytes of coded data in in.  Returns false
+  /// if the code lengths in the data are invalid.
+  bool canonical_huffman_uncompress(const unsigned char *in, size_t insize, 
+                                    unsigned char *out, size_t outsize);
+
+} // namespace
+
+#endif // WT_CANONICAL_HUFFMAN_H
@@ -33,28 +33,43 @@
 #define WT_EZW_H
 
 #include <climits>
+#include <algorithm>
 #include <deque>
+#include <vector>
 #include "ac_obitstream.h"
 #include "buffered_obitstream.h"
 #include "ac_ibitstream.h"
 #include "buffered_ibitstream.h"
+#include "filter_bank.h"
+#include "wavelet.h"
 
 namespace wavelet {
 
-  /// All input data is converted to this type before coding.
-  typedef long long quantized_t;  
-  
-  /// Minimum value of a quantized_t; be sure to keep this synced.
-  const quantized_t Q_MIN = LONG_LONG_MIN;  
-  
-  /// Possible types of encoding to use for encoding after rle-encoding ezw data 
-  typedef enum { NONE, RLE, HUFFMAN, ARITHMETIC } encoding_t;
+  /// Possible types of encoding to use for encoding after rle-encoding ezw data.  RANGE 
+  /// codes ezw bits directly with a context-modeling range coder instead, without rle.
+  typedef enum { NONE, RLE, HUFFMAN, ARITHMETIC, RANGE } encoding_t;
 
   /// Helpful for input
   encoding_t str_to_encoding(const char *str);
   const char *encoding_to_str(encoding_t enc_type);
   std::ostream& operator<<(std::ostream& out, encoding_t enc_type);  
+
+  /// Version of the ezw format written by this library.  Version 0 data was huffman coded
+  /// with a tree stored in the data; version 1 uses canonical huffman codes.  Other 
+  /// encodings are the same in all versions, so only huffman headers carry a version.
+  const size_t EZW_VERSION = 1;
   
+  /// Sizes of a separately coded segment of ezw data.  See ezw_header::segments.
+  struct ezw_segment {
+    size_t ezw_size;        // Size of the segment's ezw bits
+    size_t rle_size;        // Size of the segment after rle coding
+    size_t enc_size;        // Size of the fully encoded segment
+
+    ezw_segment(size_t e = 0, size_t r = 0, size_t n = 0) 
+      : ezw_size(e), rle_size(r), enc_size(n) { }
+  };
+
+
   /// This is all the data needed by the decoder to parse the encoder's output.
   struct ezw_header {
     // initialized fields (set in constructor)
@@ -65,8 +80,19 @@ namespace wavelet {
     unsigned long long scale;  // Scaling factor applied to data before encoding
     quantized_t threshold;     // Initial ezw threshold for data in this file.
     encoding_t enc_type;       // Type of encoding used on rle buffer.
+    size_t version;            // Format version of the encoded data.  See EZW_VERSION.
+    filter_t filter;           // Wavelet the data was transformed with.
     size_t blocks;             // For parallel encoding -- count of independently encoded blocks
     size_t passes;             // Needed for block coding: total number of ezw passes encoded.
+    size_t data_rows;          // Rows of actual data, if the matrix was padded.  Same as rows otherwise.
+    size_t data_cols;          // Cols of actual data, if the matrix was padded.  Same as cols otherwise.
+    size_t index_stride;       // Blocks per entry in block_index, or per run in segments.
+    std::vector<size_t> block_index;  // Bytes of ezw data in each run of index_stride blocks, in 
+                                      // decode order.  Lets decoders find blocks without decoding.
+    size_t segment_passes;     // Passes per run of blocks in segments.
+    std::vector<ezw_segment> segments;  // Separately coded segments, one per pass for each run of
+                                        // index_stride blocks, run-major.  Each holds its pass for
+                                        // every block in its run, in decode order.
 
     // un-initialized fields (must be set manually)
     size_t ezw_size;        // Size of ezw-encoded bitstream
@@ -78,6 +104,30 @@ namespace wavelet {
     ezw_header(size_t r, size_t c, int l, quantized_t m, unsigned long long s, quantized_t t, 
                encoding_t et = ARITHMETIC, size_t b = 1, size_t p = 0);
     
+    /// True if the encoded matrix is bigger than the actual data.
+    bool padded() const {
+      return data_rows != rows || data_cols != cols;
+    }
+
+    /// True if the header says where blocks start in the ezw data.
+    bool indexed() const {
+      return !block_index.empty();
+    }
+
+    /// True if ezw data was split into separately coded segments.  Passes are byte-aligned
+    /// in segmented data, so that they can be split.
+    bool segmented() const {
+      return !segments.empty();
+    }
+
+    /// Sets block_index up with at most max_entries entries from per-block byte counts, 
+    /// indexed by block id.  Consecutive blocks in decode order share entries as needed.
+    void build_index(const std::vector<size_t>& block_bytes, size_t max_entries);
+
+    /// Data extents are only written out for padded matrices, the block index and 
+    /// segment sizes only if there are any, the version only for nonzero versions of 
+    /// huffman data, and the filter only if it isn't CDF97, so other headers are the same
+    /// as they always were.  Older readers can't read version 1 huffman data.
     size_t write_out(std::ostream& out);
     static void read_in(std::istream& in, ezw_header& header);
   };
@@ -97,6 +147,30 @@ namespace wavelet {
   } ezw_code;
 
 
+  /// Context-modeling coders (see RANGE) code each ezw bit in one of these contexts.
+  /// Dominant pass symbols are two bits: whether a coefficient is significant, then its 
+  /// sign or whether it roots a zerotree.  These get separate contexts for each level, 
+  /// split further by the previous symbol in the pass.  Subordinate pass bits share one.
+  const int MAX_CONTEXT_LEVEL = 15;
+  const size_t SIGNIFICANCE_CONTEXTS = 0;
+  const size_t SIGN_CONTEXTS         = SIGNIFICANCE_CONTEXTS + 4 * (MAX_CONTEXT_LEVEL + 1);
+  const size_t ZEROTREE_CONTEXTS     = SIGN_CONTEXTS + (MAX_CONTEXT_LEVEL + 1);
+  const size_t REFINEMENT_CONTEXT    = ZEROTREE_CONTEXTS + 4 * (MAX_CONTEXT_LEVEL + 1);
+  const size_t NUM_EZW_CONTEXTS      = REFINEMENT_CONTEXT + 1;
+
+  inline size_t significance_context(int level, ezw_code prev) {
+    return SIGNIFICANCE_CONTEXTS + 4 * std::min(level, MAX_CONTEXT_LEVEL) + prev;
+  }
+
+  inline size_t sign_context(int level) {
+    return SIGN_CONTEXTS + std::min(level, MAX_CONTEXT_LEVEL);
+  }
+
+  inline size_t zerotree_context(int level, ezw_code prev) {
+    return ZEROTREE_CONTEXTS + 4 * std::min(level, MAX_CONTEXT_LEVEL) + prev;
+  }
+
+
   /// These go in the subordinate pass's list
   struct sub_elt {
     size_t row;
@@ -133,7 +207,8 @@ namespace wavelet {
       if (code == STOP) return false;
 
       if (e.level == 0) {
-        // put children of level zero values on the queue
+        // put children of level zero values on the queue, if data was transformed at all
+        if (low_rows == rows) continue;
         dom_queue.push_back(dom_elt(e.row,          e.col+low_cols, 1));
         dom_queue.push_back(dom_elt(e.row+low_rows, e.col,          1));
         dom_queue.push_back(dom_elt(e.row+low_rows, e.col+low_cols, 1));
@@ -180,7 +255,8 @@ namespace wavelet {
       if (code == STOP) return false;
 
       if (e.level == 0) {
-        // put children of level zero values on the queue
+        // put children of level zero values on the queue, if data was transformed at all
+        if (low_rows == rows) continue;
         dom_queue.push_back(dom_elt(e.row+low_rows, e.col+low_cols, 1));
         dom_queue.push_back(dom_elt(e.row+low_rows, e.col,          1));
         dom_queue.push_back(dom_elt(e.row,          e.col+low_cols, 1));
@@ -65,11 +65,22 @@ namespace wavelet {
     ///               the level of transform that encoded the data)
     /// header        Provide the header if it has already been read in.
     /// Return:
-    ///     level of inverse transform to apply to decoded data.
+    ///     level of inverse transform to apply to decoded data.  Lossless data (see 
+    ///     ezw_encoder::set_lossless()) is inverse-transformed here, so this is 0 for it.
     /// 
     /// TODO: move approx level to a setter for consistency
     int decode(std::istream& in, wt_matrix& mat, int level = -1, 
                const ezw_header *header = NULL);
+
+    /// Trims padding recorded in the header off of reconstructed data, i.e. data that has
+    /// been decoded and fully inverse-transformed.  Reduced-size reconstructions (see 
+    /// decode()) are trimmed in proportion to their size.
+    static void trim(wt_matrix& mat, const ezw_header& header);
+
+    /// Skips over the encoded data that follows a header, leaving in at the start of 
+    /// whatever comes next, e.g. the next header in a stream of appended encodings.
+    /// This only reads block sizes, so it's much cheaper than decoding.
+    static void skip(std::istream& in, const ezw_header& header);
     
     size_t get_pass_limit();
     void set_pass_limit(size_t limit);
@@ -78,36 +89,81 @@ namespace wavelet {
     void set_byte_budget(size_t budget);
     
     size_t get_bytes_read();
+
+    /// Sets the number of threads to decode with.  Blocks are only decoded concurrently
+    /// if the encoder wrote a block index or segments.  Defaults to 1.
+    void set_threads(size_t threads);
+    size_t get_threads();
+
+    /// Sets a range [begin, end) of blocks to decode, where blocks are the processes that 
+    /// encoded the data in parallel.  Only applies to data with a block index or segments,
+    /// and all blocks in a run of blocks that overlaps the range are decoded.  Segments for 
+    /// other runs aren't even read.  An end of zero (the default) means all blocks.
+    void set_block_range(size_t begin, size_t end);
     
   protected:
     wt_matrix *decoded;                 /// Pointer to the destination matrix
-    quantized_t threshold;              /// Current threshold for the coder.
-    std::vector<sub_elt> sub_list;      /// accumulated subordinate pass coefficients
 
     size_t pass_limit;                  /// Limit on number of passes to decode
     size_t byte_budget;                 /// Limit on number of passes to decode
     size_t bytes_read;                  /// Bytes read by last call to decode()
+    size_t threads;                     /// Threads to decode blocks with
+    size_t block_begin;                 /// First block to decode
+    size_t block_end;                   /// End of blocks to decode, or 0 for all
+
+    /// Decoding state for one block.  Blocks write to disjoint parts of the decoded
+    /// matrix, so threads can decode different blocks at once with their own state.
+    struct block_state {
+      quantized_t threshold;            /// Current threshold for the coder.
+      std::vector<sub_elt> sub_list;    /// accumulated subordinate pass coefficients
+      ezw_code prev;                    /// Last symbol decoded in the dominant pass.
+    };
+
+    /// Runs of blocks to decode, shared by decoding threads.  See ezw_decoder.C.
+    struct block_queue;
 
     /// EZW-codes a single value according to the current threshold.  Appends to
     /// dom_queue or sub_list as necessary.
-    ezw_code decode_value(dom_elt e, ibitstream& in);
+    template <class IBits>
+    ezw_code decode_value(dom_elt e, IBits& in, block_state& state);
     
     /// Subordinate pass of EZW algorithm.  ee Shapiro, 1993 for info.
-    bool subordinate_pass(ibitstream& in);
+    template <class IBits>
+    bool subordinate_pass(IBits& in, block_state& state);
+
+    /// Decodes blocks [begin, end) of the blocks in decode order from in, which
+    /// starts at the first of them.  Returns bytes read.  Templated on the concrete
+    /// type of the input stream, so that bits are read with inlined, non-virtual calls.
+    template <class IBits>
+    size_t decode_blocks(IBits& in, const ezw_header& header, 
+                         const std::vector<size_t>& order, size_t begin, size_t end);
+
+    /// Decodes blocks [begin, end) of the blocks in decode order from the segments of a run
+    /// in queue.  Segments hold a pass for all the blocks.  Returns bytes read.
+    size_t decode_segments(block_queue& queue, size_t run, size_t begin, size_t end);
+
+    /// Thread routine that decodes runs of blocks from a block_queue until there are none left.
+    static void *decode_thread(void *queue);
 
     /// Gets RLE encoded data out of file based on encoding info
     void initial_decode(std::vector<unsigned char>& dest, std::istream& in, const ezw_header& header);
+
+    /// Gets ezw data out of an encoding of the given sizes, coded as header says.
+    static void initial_decode(std::vector<unsigned char>& dest, std::istream& in, 
+                               const ezw_header& header, const ezw_segment& sizes);
     
     /// Used by dominant pass to decode valus in a bitstream.  See
     /// ezw.h for traversals in which this can be used.
+    template <class IBits>
     struct decode_visitor {
       ezw_decoder *parent;
-      ibitstream& in;
+      IBits& in;
+      block_state& state;
 
-      decode_visitor(ezw_decoder *p, ibitstream& i): parent(p), in(i) { }
+      decode_visitor(ezw_decoder *p, IBits& i, block_state& s): parent(p), in(i), state(s) { }
       ~decode_visitor() { }
       ezw_code visit(dom_elt e) { 
-        return parent->decode_value(e, in);
+        return parent->decode_value(e, in, state);
       }
     };
 
@@ -35,6 +35,7 @@
 #include <deque>
 #include <vector>
 #include <climits>
+#include <stdint.h>
 
 #include "ezw.h"
 #include "wavelet.h"
@@ -42,6 +43,23 @@
 
 namespace wavelet {
 
+  /// Row-major view of quantized coefficients.  The encoder stores coefficients and its
+  /// zerotree map as 32-bit integers when they're small enough, or as quantized_t, in
+  /// storage of its own or in the buffer of the matrix being encoded.
+  template <class Q>
+  struct coeff_view {
+    typedef Q value_type;
+    Q *data;
+    size_t rows;
+    size_t cols;
+
+    coeff_view(Q *d = NULL, size_t r = 0, size_t c = 0) : data(d), rows(r), cols(c) { }
+    Q& operator()(size_t r, size_t c) const { return data[r * cols + c]; }
+    size_t size1() const { return rows; }
+    size_t size2() const { return cols; }
+  };
+
+
   /// This class provides methods for encoding wavelet matrices 
   /// using Shapiro's EZW method.
   class ezw_encoder {
@@ -62,7 +80,7 @@ namespace wavelet {
     /// stream.  
     /// 
     /// Params:
-    /// mat         Wavelet-transformed input data.
+    /// mat         Wavelet-transformed input data, or untransformed data in lossless mode.
     /// out         Output stream to write encoded data to.
     /// level       Level of the wavelet transform that was applied to the 
     ///             input data.  Assumes maximal if not provided.
@@ -71,7 +89,10 @@ namespace wavelet {
     /// 
     /// Return value:
     ///     Number of bytes written out.
-    size_t encode(wt_matrix& mat, std::ostream& out, int level = -1);
+    ///
+    /// This is instantiated for matrices of doubles and floats (wt_matrix and wt_matrix_f).
+    template <class T>
+    size_t encode(boost::numeric::ublas::matrix<T>& mat, std::ostream& out, int level = -1);
     
     /// Number of EZW passes to encode; 0 for no limit.
     int get_pass_limit();
@@ -91,12 +112,62 @@ namespace wavelet {
     /// Set whether to use arithmetic coding (default is true)
     void set_encoding_type(encoding_t enc_type);
 
+    /// Sets the extents of the actual data, if the matrix passed to encode() was padded 
+    /// out to make it transformable.  These go in the header so that decoders can trim 
+    /// the padding.  Zero (the default) means the whole matrix is data.
+    void set_data_extents(size_t rows, size_t cols);
+
+    /// Sets whether each pass is coded as a separate segment, with an index of segment 
+    /// sizes in the header.  Decoders can then read only the passes they need, and in
+    /// parallel, only the blocks they need.  Restarting coding costs some compression, 
+    /// especially with huffman coding.  Range coded output is never segmented.  Defaults
+    /// to false.
+    void set_segmented(bool segmented);
+
+    /// Whether passes are coded as separate segments.
+    bool get_segmented();
+
+    /// Sets the wavelet that the input was transformed with.  This goes in the header,
+    /// so that decoders can invert the transform.  Defaults to CDF97.
+    void set_filter(filter_t filter);
+
+    /// Wavelet that the input was transformed with.
+    filter_t get_filter();
+
+    /// Sets whether encode() is lossless.  In lossless mode, encode() takes untransformed
+    /// data, quantizes it, and does the reversible integer transform in wt_reversible.h 
+    /// itself.  All passes are coded, so decoders reconstruct the quantized data exactly.
+    /// The filter goes in the header as INT53, and the pass limit is ignored.  This is 
+    /// for sequential encoding; par_ezw_encoder doesn't support it.  Defaults to false.
+    void set_lossless(bool lossless);
+
+    /// Whether encode() is lossless.
+    bool get_lossless();
+
+    /// Sets whether encode() may quantize into the buffer of the matrix it's given, 
+    /// instead of into a copy.  The matrix's contents are undefined afterwards.  When
+    /// values fit in 32 bits, the zerotree map goes there too if there's room.  This 
+    /// has no effect in lossless mode.  Defaults to false.
+    void set_in_place(bool in_place);
+
+    /// Whether encode() may quantize into the matrix it's given.
+    bool get_in_place();
+
   protected:
-    /// Values from input matrix, quantized.
-    boost::numeric::ublas::matrix<quantized_t> quantized;
+    /// Values from input matrix, quantized, if they need more than 32 bits.
+    quantized_matrix quantized;
+
+    /// map of zero trees for encoding step, if values need more than 32 bits.
+    quantized_matrix zerotree_map;
+
+    /// 32-bit coefficients and zerotree map that aren't in the input matrix.
+    std::vector<int32_t> narrow_storage;
 
-    /// map of zero trees for encoding step
-    boost::numeric::ublas::matrix<quantized_t> zerotree_map;
+    bool narrow;                       /// Whether coefficients are 32-bit for this encode().
+    coeff_view<quantized_t> wide_coeffs;   /// Quantized values, if not narrow.
+    coeff_view<quantized_t> wide_map;      /// Zerotree map, if not narrow.
+    coeff_view<int32_t> narrow_coeffs;     /// Quantized values, if narrow.
+    coeff_view<int32_t> narrow_map;        /// Zerotree map, if narrow.
 
     size_t low_rows;                   /// Rows in lowest frequency pass
     size_t low_cols;                   /// Cols in lowest frequency pass
@@ -104,6 +175,12 @@ namespace wavelet {
     size_t pass_limit;                 /// Max number of EZW passes to output
     quantized_t scale;                 /// pre-transform scaling factor.
     encoding_t enc_type;               /// Type of encoding for output.  Defaults to huffman.
+    size_t data_rows;                  /// Rows of actual data in input, or 0 if not padded.
+    size_t data_cols;                  /// Cols of actual data in input, or 0 if not padded.
+    bool segmented;                    /// Whether passes are coded as separate segments.
+    filter_t filter;                   /// Wavelet the input was transformed with.
+    bool lossless;                     /// Whether encode() transforms losslessly itself.
+    bool in_place;                     /// Whether encode() may quantize into its input.
 
     /// Number of bits in each ezw pass (used by parallel version)
     std::vector<size_t> dom_sizes;
@@ -111,36 +188,55 @@ namespace wavelet {
 
     quantized_t threshold;              /// Current threshold for the coder.   
     std::vector<quantized_t> sub_list;  /// accumulated subordinate pass coefficients
+    ezw_code prev_code;                 /// Last symbol coded in the dominant pass.
 
 
     /// EZW-codes a single value according to the current threshold.  
     /// Appends to dom_queue, and sub_list if necessary.
-    ezw_code encode_value(dom_elt e, obitstream& out);
+    template <class OBits, class Q>
+    ezw_code encode_value(dom_elt e, OBits& out, coeff_view<Q> coeffs, coeff_view<Q> map);
 
     /// Subordinate pass of EZW algorithm.  ee Shapiro, 1993 for info.
-    void subordinate_pass(obitstream& out);
+    template <class OBits>
+    void subordinate_pass(OBits& out);
 
     /// gets level of transform based on size of matrix.
     int get_level(int level, size_t rows, size_t cols);
 
-    /// Multiplies each value in the matrix by a scale factor then casts it to quantized_t.
-    /// Stored results in an internal matrix of quantized values.
-    void quantize(wt_matrix& mat, quantized_t scale);
+    /// Records extents set with set_data_extents(), and the filter, in the header.
+    void set_header_extents(ezw_header& header);
+
+    /// Whether quantized values will fit in 32 bits, after the mean is subtracted, given the
+    /// largest magnitude in the input times the scale.  Never true in lossless mode.
+    bool fits_narrow(double scaled_abs_max);
+
+    /// Multiplies each value in the matrix by a scale factor then rounds it to an integer.
+    /// Results are stored as 32-bit integers if narrow is set, and as quantized_t otherwise,
+    /// in the matrix's own buffer if in_place is set and there's room.  Products are taken 
+    /// in double precision for any type of matrix.
+    template <class T>
+    void quantize(boost::numeric::ublas::matrix<T>& mat, quantized_t scale, bool use_narrow);
     
-    /// Build zerotree map.  Map is constructed from quantized and stored in zerotree_map.
-    /// Threshold can be simply ANDed with zerotree_map values to determine if a cell is a 
-    /// zerotree root.
+    /// Build zerotree map.  Map is constructed from coeffs and stored in map.
+    /// Threshold can be simply ANDed with map values to determine if a cell is a 
+    /// zerotree root.  Levels are reduced iteratively, finest first, a row at a time.
     /// See Shapiro 1996, "A Fast Technique for Finding Zerotrees in the EZW Algorithm".
-    void build_zerotree_map();
+    template <class Q>
+    void build_zerotree_map(coeff_view<Q> coeffs, coeff_view<Q> map);
+
+    /// Sum of quantized values.
+    quantized_t quantized_sum();
 
-    /// Recursive helper for build_zerotree_map().  
-    quantized_t zerotree_map_encode(size_t r, size_t c);
+    /// Largest magnitude of quantized values.
+    quantized_t quantized_abs_max();
 
-    /// Subtracts the provided scalar value from the entire quantized matrix.
+    /// Subtracts the provided scalar value from all quantized values.
     void subtract_scalar(quantized_t scalar);
     
     /// Does the actual work of the EZW algorithm; used by both sequential and parallel
-    /// calls above.
+    /// calls above.  This is templated on the concrete type of the output stream, so that
+    /// bits are put with inlined, non-virtual calls.  It's instantiated in ezw_encoder.C
+    /// for vector_obitstream and range_obitstream.
     /// 
     /// PRE: threshold has been set according to max value in array.
     /// 
@@ -151,7 +247,13 @@ namespace wavelet {
     /// 
     /// Return value:
     ///     Number of bytes written to output stream by the encoder
-    void do_encode(obitstream& out, ezw_header& header, bool byte_align);
+    template <class OBits>
+    void do_encode(OBits& out, ezw_header& header, bool byte_align);
+
+    /// Does passes for do_encode() on 32-bit or quantized_t coefficients.
+    template <class OBits, class Q>
+    void encode_passes(OBits& out, ezw_header& header, bool byte_align, 
+                       coeff_view<Q> coeffs, coeff_view<Q> map);
 
 
     /// Finishes encoding by coding buf and writing out to file.
@@ -159,17 +261,27 @@ namespace wavelet {
     /// If pre_rle is specified the buffer is assumed to already be rle coded.
     size_t finish_encode(std::vector<unsigned char>& buf, std::ostream& out, ezw_header& header, bool rle = false);
 
+    /// Finishes segmented encoding by separately coding each segment and writing them out 
+    /// after the header.  Segments hold ezw data for each of passes passes of each run of 
+    /// header.index_stride blocks, run-major.  Returns size of output, including header.
+    size_t finish_segmented(std::vector< std::vector<unsigned char> >& segments, size_t passes,
+                            std::ostream& out, ezw_header& header);
+
 
     /// Used by dominant pass to encode valus in a bitstream.  See
     /// ezw.h for traversals in which this can be used.
+    template <class OBits, class Q>
     struct encode_visitor {
       ezw_encoder *parent;
-      obitstream& out;
+      OBits& out;
+      coeff_view<Q> coeffs;
+      coeff_view<Q> map;
       
-      encode_visitor(ezw_encoder *p, obitstream& o): parent(p), out(o) { }
+      encode_visitor(ezw_encoder *p, OBits& o, coeff_view<Q> c, coeff_view<Q> m)
+        : parent(p), out(o), coeffs(c), map(m) { }
       ~encode_visitor() { }
       ezw_code visit(dom_elt e) { 
-        return parent->encode_value(e, out);
+        return parent->encode_value(e, out, coeffs, map);
       }
     };
 
@@ -33,6 +33,7 @@
 #define WT_FILTER_H
 
 #include <cstdlib>
+#include <iostream>
 
 /// \file filter_bank.h
 /// This file provides declarations for the filter banks used by
@@ -51,6 +52,24 @@ namespace wavelet {
 		          const double *ilpf = NULL, const double *ihpf = NULL);
     ~filter_bank();
   };
+
+  /// Wavelets that transforms can use.  Each has a filter bank for direct transforms 
+  /// and a lifting scheme (see lifting.h), which give the same results.  Values are 
+  /// recorded in ezw headers, so don't change them.
+  ///
+  /// INT53 is the reversible integer 5/3 transform in wt_reversible.h, which only 
+  /// ezw_encoder's lossless mode does.  Floating-point transforms use CDF53 for it.
+  typedef enum { CDF97 = 0, CDF53 = 1, HAAR = 2, INT53 = 3 } filter_t;
+
+  /// Helpful for input
+  filter_t str_to_filter(const char *str);
+  const char *filter_to_str(filter_t filter);
+  std::ostream& operator<<(std::ostream& out, filter_t filter);
+
+  namespace filter {
+    /// Returns the singleton filter bank for a wavelet.
+    filter_bank& get(filter_t f);
+  }
   
 } //namespaces
 
@@ -48,6 +48,10 @@ namespace wavelet {
     /// of the result.
     virtual unsigned get_bit() = 0;
     
+    /// Gets a bit that was put in the stream in some context.  See 
+    /// obitstream::put_context_bit().  Default implementation calls get_bit().
+    virtual unsigned get_context_bit(size_t context);
+
     /// Whether data from the bitstream is still valid.
     virtual bool good() = 0;
 
@@ -0,0 +1,276 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC.  
+// Produced at the Lawrence Livermore National Laboratory  
+// Written by Todd Gamblin, tgamblin@llnl.gov.
+// LLNL-CODE-417602
+// All rights reserved.  
+// 
+// This file is part of Libra. For details, see http://github.com/tgamblin/libra.
+// Please also read the LICENSE file for further information.
+// 
+// Redistribution and use in source and binary forms, with or without modification, are
+// permitted provided that the following conditions are met:
+// 
+//  * Redistributions of source code must retain the above copyright notice, this list of
+//    conditions and the disclaimer below.
+//  * Redistributions in binary form must reproduce the above copyright notice, this list of
+//    conditions and the disclaimer (as noted below) in the documentation and/or other materials
+//    provided with the distribution.
+//  * Neither the name of the LLNS/LLNL nor the names of its contributors may be used to endorse
+//    or promote products derived from this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+// OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+// LAWRENCE LIVERMORE NATIONAL SECURITY, LLC, THE U.S. DEPARTMENT OF ENERGY OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+// ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+/////////////////////////////////////////////////////////////////////////////////////////////////
+#ifndef WT_LIFTING_H
+#define WT_LIFTING_H
+
+#include <cstdlib>
+#include "filter_bank.h"
+
+/// \file lifting.h
+/// Lifting schemes for wt_1d_lift and wt_lift.  A scheme is a type whose step count
+/// and coefficients are compile-time constants, so each scheme gets its own copy of
+/// the kernels here, with every step unrolled.
+///
+/// Steps alternate, starting with a predict step, which adds multiples of each odd 
+/// sample's even neighbors to it.  Update steps do the same for even samples.  Edges 
+/// are extended symmetrically.  After the last step, even samples are multiplied by
+/// the scheme's scale and odd samples are divided by it.  The results are the same
+/// as a direct transform with the wavelet's filter bank.
+///
+/// Kernels work on tiles of w adjacent columns.  Element (i, j) of a tile is 
+/// data[i*stride + j*step].  For step == 1 each row of the tile is contiguous, so 
+/// the inner loops run along rows and the compiler can vectorize them.  Single 
+/// columns and rows go through the same code with w = 1, so transforms of either 
+/// give bit-identical results.
+namespace wavelet { namespace lifting {
+
+  /// Lifting scheme for Cohen-Daubechies-Feauveau 9/7 wavelets.
+  struct cdf97 {
+    enum { steps = 4, symmetric = 1 };
+
+    /// Coefficient of each sample's left neighbor in step k.
+    static double left(int k) {
+      static const double c[] = {
+        -1.5861343420693648,
+        -0.0529801185718856,
+        0.8829110755411875,
+        0.4435068520511142
+      };
+      return c[k];
+    }
+
+    /// Coefficient of each sample's right neighbor in step k.
+    static double right(int k) { return left(k); }
+
+    static double scale() { return 1.1496043988602418; }
+  };
+
+
+  /// Lifting scheme for Cohen-Daubechies-Feauveau 5/3 (LeGall) wavelets.  Coefficients
+  /// are dyadic, so the steps are exact on integers that aren't too large.
+  struct cdf53 {
+    enum { steps = 2, symmetric = 1 };
+    static double left(int k) { return k ? 0.25 : -0.5; }
+    static double right(int k) { return left(k); }
+    static double scale() { return 1.4142135623730951; }
+  };
+
+
+  /// Lifting scheme for Haar wavelets.  The detail is the difference of each pair of 
+  /// samples, so piecewise-constant data has few nonzero coefficients.
+  struct haar {
+    enum { steps = 2, symmetric = 0 };
+    static double left(int k) { return k ? 0.0 : -1.0; }
+    static double right(int k) { return k ? 0.5 : 0.0; }
+    static double scale() { return 1.4142135623730951; }
+  };
+
+
+  /// Predict step: odd rows are updated from their even neighbors.
+  template <bool Symmetric>
+  inline void predict(double *data, size_t stride, size_t step, size_t w, size_t n, 
+                      double l, double r) {
+    for (size_t i=1; i < n-2; i+=2) {
+      double *cur = data + i * stride;
+      const double *prev = cur - stride;
+      const double *next = cur + stride;
+      if (Symmetric) {
+        for (size_t j=0; j < w; j++) cur[j*step] += l*(prev[j*step] + next[j*step]);
+      } else {
+        for (size_t j=0; j < w; j++) cur[j*step] += l*prev[j*step] + r*next[j*step];
+      }
+    }
+
+    // last odd row's right neighbor is the mirror of its left.
+    const double edge = Symmetric ? 2*l : l + r;
+    double *last = data + (n-1) * stride;
+    const double *prev = last - stride;
+    for (size_t j=0; j < w; j++) last[j*step] += edge*prev[j*step];
+  }
+
+
+  /// Update step: even rows are updated from their odd neighbors.
+  template <bool Symmetric>
+  inline void update(double *data, size_t stride, size_t step, size_t w, size_t n, 
+                     double l, double r) {
+    for (size_t i=2; i < n; i+=2) {
+      double *cur = data + i * stride;
+      const double *prev = cur - stride;
+      const double *next = cur + stride;
+      if (Symmetric) {
+        for (size_t j=0; j < w; j++) cur[j*step] += l*(prev[j*step] + next[j*step]);
+      } else {
+        for (size_t j=0; j < w; j++) cur[j*step] += l*prev[j*step] + r*next[j*step];
+      }
+    }
+
+    // first even row's left neighbor is the mirror of its right.
+    const double edge = Symmetric ? 2*l : l + r;
+    const double *next = data + stride;
+    for (size_t j=0; j < w; j++) data[j*step] += edge*next[j*step];
+  }
+
+
+  /// Scale step: odd rows are multiplied by a, even rows divided by it.
+  inline void scale(double *data, size_t stride, size_t step, size_t w, size_t n, double a) {
+    for (size_t i=0; i < n; i++) {
+      double *row = data + i * stride;
+      if (i%2) for (size_t j=0; j < w; j++) row[j*step] *= a;
+      else     for (size_t j=0; j < w; j++) row[j*step] /= a;
+    }
+  }
+
+
+  /// Steps [Step, steps) of a scheme, unrolled at compile time.
+  template <class Scheme, int Step = 0, bool Done = (Step >= (int)Scheme::steps)>
+  struct lift_steps {
+    static inline void forward(double *data, size_t stride, size_t step, size_t w, size_t n) {
+      apply(data, stride, step, w, n, Scheme::left(Step), Scheme::right(Step));
+      lift_steps<Scheme, Step+1>::forward(data, stride, step, w, n);
+    }
+
+    static inline void inverse(double *data, size_t stride, size_t step, size_t w, size_t n) {
+      lift_steps<Scheme, Step+1>::inverse(data, stride, step, w, n);
+      apply(data, stride, step, w, n, -Scheme::left(Step), -Scheme::right(Step));
+    }
+
+    static inline void apply(double *data, size_t stride, size_t step, size_t w, size_t n,
+                             double l, double r) {
+      if (Step % 2 == 0) {
+        predict<Scheme::symmetric>(data, stride, step, w, n, l, r);
+      } else {
+        update<Scheme::symmetric>(data, stride, step, w, n, l, r);
+      }
+    }
+  };
+
+  template <class Scheme, int Step>
+  struct lift_steps<Scheme, Step, true> {
+    static inline void forward(double *, size_t, size_t, size_t, size_t) { }
+    static inline void inverse(double *, size_t, size_t, size_t, size_t) { }
+  };
+
+
+  /// All forward lifting steps of a scheme on a tile, without packing.
+  template <class Scheme>
+  inline void lift(double *data, size_t stride, size_t step, size_t w, size_t n) {
+    lift_steps<Scheme>::forward(data, stride, step, w, n);
+    scale(data, stride, step, w, n, 1/Scheme::scale());
+  }
+
+
+  /// All inverse lifting steps of a scheme on an unpacked tile.
+  template <class Scheme>
+  inline void unlift(double *data, size_t stride, size_t step, size_t w, size_t n) {
+    scale(data, stride, step, w, n, Scheme::scale());
+    lift_steps<Scheme>::inverse(data, stride, step, w, n);
+  }
+
+
+  /// Forward reversible 5/3 lifting on a tile of integers, as in JPEG 2000.  Steps are 
+  /// the same as cdf53's, but each one's sum is rounded down with a shift, and there's 
+  /// no scale step, so the inverse undoes them exactly.
+  template <class T>
+  inline void lift_int53(T *data, size_t stride, size_t step, size_t w, size_t n) {
+    // predict: odd rows lose the mean of their neighbors.
+    for (size_t i=1; i < n; i+=2) {
+      T *cur = data + i * stride;
+      const T *prev = cur - stride;
+      const T *next = (i+1 < n) ? cur + stride : prev;
+      for (size_t j=0; j < w; j++) cur[j*step] -= (prev[j*step] + next[j*step]) >> 1;
+    }
+
+    // update: even rows gain a quarter of their neighbors.
+    for (size_t i=0; i < n; i+=2) {
+      T *cur = data + i * stride;
+      const T *next = cur + stride;
+      const T *prev = i ? cur - stride : next;
+      for (size_t j=0; j < w; j++) cur[j*step] += (prev[j*step] + next[j*step] + 2) >> 2;
+    }
+  }
+
+
+  /// Inverse of lift_int53().
+  template <class T>
+  inline void unlift_int53(T *data, size_t stride, size_t step, size_t w, size_t n) {
+    for (size_t i=0; i < n; i+=2) {
+      T *cur = data + i * stride;
+      const T *next = cur + stride;
+      const T *prev = i ? cur - stride : next;
+      for (size_t j=0; j < w; j++) cur[j*step] -= (prev[j*step] + next[j*step] + 2) >> 2;
+    }
+
+    for (size_t i=1; i < n; i+=2) {
+      T *cur = data + i * stride;
+      const T *prev = cur - stride;
+      const T *next = (i+1 < n) ? cur + stride : prev;
+      for (size_t j=0; j < w; j++) cur[j*step] += (prev[j*step] + next[j*step]) >> 1;
+    }
+  }
+
+
+  /// Forward lifting steps on a tile with the scheme for filter.
+  inline void lift(filter_t filter, double *data, size_t stride, size_t step, size_t w, size_t n) {
+    switch (filter) {
+    case CDF53:
+    case INT53:
+      lift<cdf53>(data, stride, step, w, n);
+      break;
+    case HAAR:
+      lift<haar>(data, stride, step, w, n);
+      break;
+    default:
+      lift<cdf97>(data, stride, step, w, n);
+      break;
+    }
+  }
+
+
+  /// Inverse lifting steps on a tile with the scheme for filter.
+  inline void unlift(filter_t filter, double *data, size_t stride, size_t step, size_t w, size_t n) {
+    switch (filter) {
+    case CDF53:
+    case INT53:
+      unlift<cdf53>(data, stride, step, w, n);
+      break;
+    case HAAR:
+      unlift<haar>(data, stride, step, w, n);
+      break;
+    default:
+      unlift<cdf97>(data, stride, step, w, n);
+      break;
+    }
+  }
+
+}} // namespaces
+
+#endif // WT_LIFTING_H
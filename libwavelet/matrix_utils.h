@@ -47,6 +47,10 @@
 /// True if and only if n is divisible by 2 <level> times.
 bool isDivisibleBy2(size_t n, int level);
 
+/// Number of times n is divisible by 2.  This is log2(n) for powers of two, and
+/// it's the number of transform levels that can be done on a dimension of length n.
+int timesDivisibleBy2(size_t n);
+
 
 template <class Matrix>
 bool in_bounds(const Matrix& mat, size_t row, size_t col) {
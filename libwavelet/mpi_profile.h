@@ -41,8 +41,10 @@
 
 #ifdef USE_PMPI
 #define MPI_Bcast         PMPI_Bcast
+#define MPI_Comm_free     PMPI_Comm_free
 #define MPI_Comm_rank     PMPI_Comm_rank
 #define MPI_Comm_size     PMPI_Comm_size
+#define MPI_Comm_split    PMPI_Comm_split
 #define MPI_Gather        PMPI_Gather
 #define MPI_Gatherv       PMPI_Gatherv
 #define MPI_Allgather     PMPI_Allgather
@@ -47,6 +47,7 @@ inline MPI_Datatype mpi_typeof(unsigned short)             {return MPI_UNSIGNED_
 inline MPI_Datatype mpi_typeof(unsigned)                   {return MPI_UNSIGNED;}
 inline MPI_Datatype mpi_typeof(unsigned long)              {return MPI_UNSIGNED_LONG;}
 inline MPI_Datatype mpi_typeof(signed long long)           {return MPI_LONG_LONG_INT;}
+inline MPI_Datatype mpi_typeof(float)                      {return MPI_FLOAT;}
 inline MPI_Datatype mpi_typeof(double)                     {return MPI_DOUBLE;}
 inline MPI_Datatype mpi_typeof(long double)                {return MPI_LONG_DOUBLE;}
 inline MPI_Datatype mpi_typeof(std::pair<int,int>)         {return MPI_2INT;}
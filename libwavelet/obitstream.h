@@ -84,6 +84,11 @@ namespace wavelet {
     /// Convenience method -- default impleemntation just calls put_zero or put_one.
     virtual void put_bit(bool bit);
 
+    /// Puts a bit that was generated in some context, e.g. one of the ezw contexts in 
+    /// ezw.h.  Context-modeling coders keep separate statistics for each context; the
+    /// default implementation ignores the context and calls put_bit.
+    virtual void put_context_bit(bool bit, size_t context);
+
   }; // obitstream
 
 } // namespace
@@ -54,17 +54,31 @@ namespace wavelet {
     /// Useful note for using streams: only the stream on process size/2 will
     /// be written to.  So if using a file stream, ONLY open the stream on 
     /// process size/2.
-    size_t encode(wt_matrix& mat, std::ostream& out, int level = -1, 
+    ///
+    /// As for ezw_encoder::encode(), mat may hold doubles or floats.
+    template <class T>
+    size_t encode(boost::numeric::ublas::matrix<T>& mat, std::ostream& out, int level = -1, 
                   MPI_Comm comm = MPI_COMM_WORLD);
     
 
     /// Sets whether this uses a traversal ordering that's compatible with the 
-    /// sequential encoder.  Defaults to false.
+    /// sequential encoder.  Defaults to false.  Sequential order output is never 
+    /// segmented (see set_segmented()), and it's arithmetic coded instead of range coded.
     void set_use_sequential_order(bool use);
     
     /// Get whether this is using reduction or gather.
     bool get_use_sequential_order();
 
+    /// Sets the maximum number of entries in the block index written for data that isn't 
+    /// in sequential order.  The index tells decoders where blocks start, so they can 
+    /// decode blocks concurrently.  Zero disables the index.  Defaults to 64.
+    /// For segmented data (see set_segmented()), this bounds the number of runs of blocks 
+    /// that passes are split into instead, and zero means a single run.
+    void set_index_entries(size_t entries);
+
+    /// Gets the maximum number of entries in the block index.
+    size_t get_index_entries();
+
     /// Gets the root of the reduction that this will do.  May not be zero.
     int get_root(MPI_Comm comm = MPI_COMM_WORLD);
 
@@ -74,12 +88,21 @@ namespace wavelet {
     /// Whether we output EZW bits in same order as sequential coder.  Defaults to false.
     bool use_sequential_order;
 
+    /// Max entries in the block index for block-encoded data.
+    size_t index_entries;
+
     size_t bit_stitch_encode(const unsigned char *passes, size_t total_bytes, std::ostream& out, 
 			     ezw_header& header, MPI_Comm comm);
     
     size_t block_encode(const unsigned char *passes, size_t total_bytes, std::ostream& out, 
 			ezw_header& header, MPI_Comm comm);
 
+    /// Gathers blocks range coded by each process to the root and writes them out in 
+    /// decode order, with a block index of their coded sizes.  ezw_bytes is the size of 
+    /// the local block before coding.
+    size_t range_block_encode(std::vector<unsigned char>& coded, size_t ezw_bytes, std::ostream& out,
+                              ezw_header& header, MPI_Comm comm);
+
     Timer timer;
   };
 
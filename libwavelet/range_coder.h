@@ -0,0 +1,62 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC.  
+// Produced at the Lawrence Livermore National Laboratory  
+// Written by Todd Gamblin, tgamblin@llnl.gov.
+// LLNL-CODE-417602
+// All rights reserved.  
+// 
+// This file is part of Libra. For details, see http://github.com/tgamblin/libra.
+// Please also read the LICENSE file for further information.
+// 
+// Redistribution and use in source and binary forms, with or without modification, are
+// permitted provided that the following conditions are met:
+// 
+//  * Redistributions of source code must retain the above copyright notice, this list of
+//    conditions and the disclaimer below.
+//  * Redistributions in binary form must reproduce the above copyright notice, this list of
+//    conditions and the disclaimer (as noted below) in the documentation and/or other materials
+//    provided with the distribution.
+//  * Neither the name of the LLNS/LLNL nor the names of its contributors may be used to endorse
+//    or promote products derived from this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+// OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+// LAWRENCE LIVERMORE NATIONAL SECURITY, LLC, THE U.S. DEPARTMENT OF ENERGY OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+// ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+/////////////////////////////////////////////////////////////////////////////////////////////////
+#ifndef RANGE_CODER_H
+#define RANGE_CODER_H
+
+#include <stdint.h>
+
+///
+/// Constants shared by range_obitstream and range_ibitstream.  These implement a binary 
+/// range coder with adaptive probabilities, in the style of the one in LZMA.  Coded data
+/// is renormalized a byte at a time, and each bit costs a multiply and a shift.
+///
+namespace wavelet {
+
+  /// Probabilities that bits are zero are kept with this many bits of precision.
+  const uint32_t RANGE_PROB_BITS = 11;
+
+  /// Probability of one, and initial probability of zero in every context.
+  const uint16_t RANGE_PROB_ONE  = (1 << RANGE_PROB_BITS);
+  const uint16_t RANGE_PROB_INIT = (RANGE_PROB_ONE >> 1);
+
+  /// Probabilities move 1/(2^RANGE_MOVE_BITS) of the way toward each coded bit.
+  const uint32_t RANGE_MOVE_BITS = 5;
+
+  /// Range is renormalized by shifting out a byte whenever it drops below this.
+  const uint32_t RANGE_TOP = (1 << 24);
+
+  /// Bytes the decoder reads to start decoding a chunk of coded data.
+  const int RANGE_INIT_BYTES = 4;
+
+} // namespace
+
+#endif // RANGE_CODER_H
@@ -0,0 +1,117 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC.  
+// Produced at the Lawrence Livermore National Laboratory  
+// Written by Todd Gamblin, tgamblin@llnl.gov.
+// LLNL-CODE-417602
+// All rights reserved.  
+// 
+// This file is part of Libra. For details, see http://github.com/tgamblin/libra.
+// Please also read the LICENSE file for further information.
+// 
+// Redistribution and use in source and binary forms, with or without modification, are
+// permitted provided that the following conditions are met:
+// 
+//  * Redistributions of source code must retain the above copyright notice, this list of
+//    conditions and the disclaimer below.
+//  * Redistributions in binary form must reproduce the above copyright notice, this list of
+//    conditions and the disclaimer (as noted below) in the documentation and/or other materials
+//    provided with the distribution.
+//  * Neither the name of the LLNS/LLNL nor the names of its contributors may be used to endorse
+//    or promote products derived from this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+// OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+// LAWRENCE LIVERMORE NATIONAL SECURITY, LLC, THE U.S. DEPARTMENT OF ENERGY OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+// ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+/////////////////////////////////////////////////////////////////////////////////////////////////
+#ifndef RANGE_IBITSTREAM_H
+#define RANGE_IBITSTREAM_H
+
+#include <vector>
+#include "ibitstream.h"
+#include "range_coder.h"
+
+namespace wavelet {
+
+  /// Input bit stream that decodes data from a range_obitstream in a buffer.  Bits need
+  /// to be read in the same contexts they were put in, and next_byte() needs to be called 
+  /// wherever the encoder ended a chunk.
+  class range_ibitstream : public ibitstream {
+  protected:
+    const unsigned char *buf;           /// Coded data.
+    const size_t size;                  /// Size of coded data.
+    size_t pos;                         /// Position of the next byte to read in buf.
+    bool past_end;                      /// Whether a read went past the end of the buffer.
+
+    std::vector<uint16_t> probs;        /// Probability of a zero in each context.
+    uint32_t range;                     /// Size of the coding interval.
+    uint32_t code;                      /// Coded value, relative to the interval.
+    bool started;                       /// Whether the current chunk has been started.
+
+    /// Next byte of input, or zero past the end.
+    unsigned char next_input() {
+      if (pos < size) return buf[pos++];
+      past_end = true;
+      return 0;
+    }
+
+    /// Reads in the start of a chunk and resets statistics.
+    void start_chunk();
+
+  public:
+    /// Constructs a range decoder to read size bytes of coded data from buf, with the
+    /// given number of contexts.
+    range_ibitstream(const unsigned char *buf, size_t size, size_t contexts = 1);
+
+    /// Destructor; does nothing.
+    virtual ~range_ibitstream();
+
+    /// Gets a bit from context 0.
+    virtual unsigned get_bit();
+
+    /// Decodes a bit in its context.
+    virtual unsigned get_context_bit(size_t context) {
+      if (!started) start_chunk();
+
+      uint16_t& prob = probs[context];
+      const uint32_t bound = (range >> RANGE_PROB_BITS) * prob;
+      unsigned bit;
+      if (code < bound) {
+        range = bound;
+        prob += (RANGE_PROB_ONE - prob) >> RANGE_MOVE_BITS;
+        bit = 0;
+      } else {
+        code -= bound;
+        range -= bound;
+        prob -= prob >> RANGE_MOVE_BITS;
+        bit = 1;
+      }
+
+      // renormalize just as the encoder did, so that chunks end where they're supposed to.
+      if (range < RANGE_TOP) {
+        range <<= 8;
+        code = (code << 8) | next_input();
+      }
+      return bit;
+    }
+
+    /// True if all data read so far was in the buffer.
+    virtual bool good() {
+      return !past_end;
+    }
+
+    /// Number of coded bytes read.
+    virtual size_t get_in_bytes();
+
+    /// Ends the current chunk.  The next bit read starts a new one.
+    virtual void next_byte();
+  };
+
+} // namespace
+
+#endif // RANGE_IBITSTREAM_H
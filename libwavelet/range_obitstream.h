@@ -0,0 +1,127 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC.  
+// Produced at the Lawrence Livermore National Laboratory  
+// Written by Todd Gamblin, tgamblin@llnl.gov.
+// LLNL-CODE-417602
+// All rights reserved.  
+// 
+// This file is part of Libra. For details, see http://github.com/tgamblin/libra.
+// Please also read the LICENSE file for further information.
+// 
+// Redistribution and use in source and binary forms, with or without modification, are
+// permitted provided that the following conditions are met:
+// 
+//  * Redistributions of source code must retain the above copyright notice, this list of
+//    conditions and the disclaimer below.
+//  * Redistributions in binary form must reproduce the above copyright notice, this list of
+//    conditions and the disclaimer (as noted below) in the documentation and/or other materials
+//    provided with the distribution.
+//  * Neither the name of the LLNS/LLNL nor the names of its contributors may be used to endorse
+//    or promote products derived from this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+// OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+// LAWRENCE LIVERMORE NATIONAL SECURITY, LLC, THE U.S. DEPARTMENT OF ENERGY OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+// ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+/////////////////////////////////////////////////////////////////////////////////////////////////
+#ifndef RANGE_OBITSTREAM_H
+#define RANGE_OBITSTREAM_H
+
+#include <vector>
+#include "obitstream.h"
+#include "range_coder.h"
+
+namespace wavelet {
+
+  /// Output bit stream that codes bits with an adaptive binary range coder.  Bits put 
+  /// in different contexts (see put_context_bit()) are modeled separately; plain bits 
+  /// go in context 0.
+  ///
+  /// Coded data is appended to a vector in chunks.  flush() and next_byte() end the
+  /// current chunk, and the next one starts over with fresh statistics.  The decoder
+  /// reads exactly the bytes written for each chunk, so chunks can be concatenated and
+  /// decoded one after another, or separately if their offsets are known.
+  class range_obitstream : public obitstream {
+  protected:
+    std::vector<unsigned char>& out;    /// Coded output is appended to this.
+    std::vector<uint16_t> probs;        /// Probability of a zero in each context.
+
+    uint64_t low;                       /// Low end of the coding interval, plus a carry bit.
+    uint32_t range;                     /// Size of the coding interval.
+    unsigned char cache;                /// Last byte shifted out, held back in case of carry.
+    size_t cache_size;                  /// Bytes held back: the cache and any 0xFFs after it.
+    bool first;                         /// Whether the next byte out is the first of a chunk.
+
+    size_t chunk_bits;                  /// Bits coded since the chunk started.
+    size_t bits;                        /// Total bits coded.
+    size_t start;                       /// Size of out when this stream was created.
+
+    /// Moves the top byte of low out toward the output, propagating carries.
+    void shift_low();
+
+    /// Writes out the rest of the current chunk, and starts a new one.
+    void end_chunk();
+
+  public:
+    /// Constructs a range coder that appends to out, with the given number of contexts.
+    range_obitstream(std::vector<unsigned char>& out, size_t contexts = 1);
+
+    /// Destructor ends the last chunk.
+    virtual ~range_obitstream();
+
+    /// Puts a zero in context 0.
+    virtual void put_zero();
+
+    /// Puts a one in context 0.
+    virtual void put_one();
+
+    /// Codes a bit in its context.
+    virtual void put_context_bit(bool bit, size_t context) {
+      uint16_t& prob = probs[context];
+      const uint32_t bound = (range >> RANGE_PROB_BITS) * prob;
+      if (!bit) {
+        range = bound;
+        prob += (RANGE_PROB_ONE - prob) >> RANGE_MOVE_BITS;
+      } else {
+        low += bound;
+        range -= bound;
+        prob -= prob >> RANGE_MOVE_BITS;
+      }
+
+      // probabilities never get closer than 1/64 to 0 or 1, so one shift renormalizes.
+      if (range < RANGE_TOP) {
+        range <<= 8;
+        shift_low();
+      }
+      chunk_bits++;
+      bits++;
+    }
+
+    /// Number of bits coded.
+    virtual size_t get_in_bits();
+
+    /// Number of bits coded, rounded up to bytes.
+    virtual size_t get_in_bytes();
+
+    /// Number of coded bits appended to the output.
+    virtual size_t get_out_bits();
+
+    /// Number of coded bytes appended to the output.
+    virtual size_t get_out_bytes();
+
+    /// Ends the current chunk.
+    virtual void flush();
+
+    /// Ends the current chunk and rounds the count of bits coded up to a byte, so that 
+    /// bit counts match those of aligned raw output.  No padding is coded.
+    virtual void next_byte();
+  };
+
+} // namespace
+
+#endif // RANGE_OBITSTREAM_H
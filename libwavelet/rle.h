@@ -53,6 +53,31 @@ size_t RLE_Rewrite(unsigned char *in, size_t insize, unsigned char *out,
 		   size_t *last_record);
 
 
+/* For compressing pieces of data with a shared marker. */
+void RLE_Histogram( unsigned char *in, size_t insize, size_t *histogram );
+unsigned char RLE_Marker( size_t *histogram );
+size_t RLE_Compress_Marker( unsigned char *in, unsigned char *out, size_t insize, 
+                            unsigned char marker );
+
+
+/* State for merging RLE buffers incrementally, without a scratch buffer
+   for the whole merge.  Holds back the last run, which may continue in
+   the next buffer appended. */
+typedef struct {
+  unsigned char marker;  /* marker for merged output */
+  unsigned char symbol;  /* symbol of held-back run */
+  size_t count;          /* length of held-back run, 0 if there is none */
+} RLE_Stream;
+
+/* Most output from appending insize bytes using the stream's marker. */
+#define RLE_STREAM_BOUND(insize) ((insize) + 8)
+
+void RLE_Stream_Init(RLE_Stream *stream, unsigned char marker);
+size_t RLE_Stream_Append(RLE_Stream *stream, unsigned char *in, size_t insize, 
+                         unsigned char marker, unsigned char *out);
+size_t RLE_Stream_Finish(RLE_Stream *stream, unsigned char *out);
+
+
 #ifdef __cplusplus
 }
 #endif
@@ -33,23 +33,29 @@
 #define VECTOR_IBITSTREAM_H
 
 #include <istream>
+#include <stdint.h>
 #include "ibitstream.h"
 #include "obitstream.h"
 
 namespace wavelet {
 
-  // Class for reading individual bits at a time from an input stream.
-  // 
-  // TODO: buffer input.
-  // TOOD: support reading large numbers of bits at a time.
+  /// Class for reading individual bits from a buffer.  Bits are loaded into a 64-bit 
+  /// word a word at a time, and get_bit() is inline, so callers that know the stream's
+  /// type (see ezw_decoder::decode_blocks()) don't need a call per bit.
   class vector_ibitstream : public ibitstream {
   protected:
     const unsigned char *buf;        /// Buffer of input characters
     const size_t end;                /// End of buffer in memory (1 past last byte)
-    size_t pos;                      /// Position in buffer to read next byte
-    unsigned char mask;              /// Mask of next bit to read.
+    size_t pos;                      /// Position in buffer of next byte to load.
+    uint64_t acc;                    /// Loaded bits not yet read, starting at the high bit.
+    size_t avail;                    /// Number of bits in acc.
     
     size_t total_bits;               /// Total bits read in.
+    bool past_end;                   /// Whether a read went past the end of the buffer.
+
+    /// Loads the next word of input into the accumulator.  Past the end of the buffer, 
+    /// this loads zeros and sets past_end.
+    void refill();
 
   public:
     /// Constructs an vector_ibitstream to read from the prvided input stream.
@@ -62,22 +68,24 @@ namespace wavelet {
     virtual ~vector_ibitstream();
 
     /// Gets a single bit of input.  Left in header to enable inlining.
-    unsigned get_bit() {
-      unsigned bit = (mask & buf[pos]) ? 1 : 0;
-      mask >>= 1;
-
-      if (mask == 0) {
-        pos++;
-        mask = 0x80;
-      }
+    virtual unsigned get_bit() {
+      if (!avail) refill();
 
+      const unsigned bit = (unsigned)(acc >> 63);
+      acc <<= 1;
+      avail--;
       total_bits++;
       return bit;
     }
 
-    /// True if there are more bits to be input.
+    /// Contexts don't matter for raw bits, so this just gets the next one.
+    virtual unsigned get_context_bit(size_t context) {
+      return vector_ibitstream::get_bit();
+    }
+
+    /// True if all bits read so far were in the buffer.
     virtual bool good() {
-      return (pos < end);
+      return !past_end;
     }
 
 
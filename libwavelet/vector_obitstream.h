@@ -35,18 +35,30 @@
 #include <iostream>
 #include <vector>
 #include <ostream>
+#include <stdint.h>
 #include "obitstream.h"
 
 namespace wavelet {
 
+  /// Output bit stream that writes to a vector.  Bits are accumulated in a 64-bit word 
+  /// and stored a word at a time, and the per-bit calls are inline, so callers that know 
+  /// the stream's type (see ezw_encoder::do_encode()) don't need a call per bit.
   class vector_obitstream : public obitstream {
   protected:
     std::vector<unsigned char>& buf;  /// Buffer for as yet unwritten data
     bool my_vector;                  /// Whether or not the vector should be freed on destruct.
-    size_t pos;                      /// Current write index in buffer.
-    unsigned char mask;              /// Mask of next bit to write.
+    size_t pos;                      /// Index in buf where bits in acc go.
+    uint64_t acc;                    /// Bits not yet stored in buf, starting at the high bit.
+    size_t acc_bits;                 /// Number of bits in acc.
     size_t bits;                     /// Total bits written out.
 
+    /// Stores a full accumulator in buf and empties it.
+    void put_word();
+
+    /// Stores all bits in the accumulator in buf, leaving any bits in a partial last 
+    /// byte in the accumulator, too.
+    void sync();
+
   public:
     /// Constructor.  Builds an obitstream to output to an internal vector.
     vector_obitstream(size_t bufsize = DEFAULT_BIT_BUFSIZE);
@@ -62,21 +74,38 @@ namespace wavelet {
 
 
     /// Puts a zero at the end of output.
-    virtual void put_zero();
+    virtual void put_zero() {
+      bits++;
+      if (++acc_bits == 64) put_word();
+    }
 
 
     /// Puts a one at the end of output.
-    virtual void put_one();
+    virtual void put_one() {
+      acc |= ((uint64_t)1 << (63 - acc_bits));
+      vector_obitstream::put_zero();
+    }
+
+
+    /// Puts a bit without branching on it.
+    virtual void put_bit(bool bit) {
+      acc |= ((uint64_t)bit << (63 - acc_bits));
+      vector_obitstream::put_zero();
+    }
+
+
+    /// Contexts don't matter for raw bits, so this just puts the bit.
+    virtual void put_context_bit(bool bit, size_t context) {
+      vector_obitstream::put_bit(bit);
+    }
 
 
-    /// Appends nbits bits from buf to the stream.  Optionally, the bits
-    /// can be taken starting from an offset (0-7) within buf.
+    /// Appends nbits bits from buf to the stream, starting at a bit offset within buf.
+    /// Bits are shifted into place 64 at a time; see insert_bits().
     virtual void write_bits(const unsigned char *buf, size_t nbits, size_t offset = 0);
 
 
-    /// Forces a write of all data in the bit buffer.  Note that this 
-    /// WILL write out any extra bits at the end of the last byte, as the
-    /// underlying output stream can only write entire bytes.
+    /// Stores all accumulated bits in the buffer, including any partial last byte.
     virtual void flush();
 
 
@@ -99,10 +128,10 @@ namespace wavelet {
     /// Skip to next byte in output.
     virtual void next_byte();
 
-    /// returns pointer to internal buffer
+    /// returns pointer to internal buffer, with all bits written so far stored in it.
     unsigned char *get_buffer();
 
-    /// Returns internal vector
+    /// Returns internal vector, with all bits written so far stored in it.
     std::vector<unsigned char>& get_vector();
 
     /// Resize the internal buffer.
@@ -34,6 +34,7 @@
 
 #include "matrix_utils.h"
 #include <algorithm>
+#include <climits>
 
 ///\file wavelet.h
 /// This header includes declarations for types used in all wavelet transforms
@@ -42,6 +43,18 @@ namespace wavelet {
   /// Matrix type used for all computations here.
   typedef boost::numeric::ublas::matrix<double> wt_matrix;
 
+  /// Single-precision matrix, for transforming and coding data that doesn't need doubles.
+  typedef boost::numeric::ublas::matrix<float> wt_matrix_f;
+
+  /// All input data is converted to this type before coding.
+  typedef long long quantized_t;  
+  
+  /// Minimum value of a quantized_t; be sure to keep this synced.
+  const quantized_t Q_MIN = LONG_LONG_MIN;  
+
+  /// Matrix of quantized data, for coders and integer transforms.
+  typedef boost::numeric::ublas::matrix<quantized_t> quantized_matrix;
+
 } // namespaces
 
 #endif // WAVELET_H
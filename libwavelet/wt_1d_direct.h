@@ -68,6 +68,19 @@ namespace wavelet {
     /// temporary storage for packing values
     std::vector<double> temp;   
 
+    /// Forward transform for raw contiguous data of any floating-point type, with buf
+    /// as temporary storage.  fwt_1d_single() is this for doubles.
+    template <class T>
+    void fwt_single(T *data, size_t n, std::vector<T>& buf);
+
+    /// Inverse transform for raw contiguous data of any floating-point type.
+    template <class T>
+    void iwt_single(T *data, size_t n, std::vector<T>& buf);
+
+    /// sym_extend() into buf instead of temp.
+    template <class T>
+    void sym_extend_into(std::vector<T>& buf, T *x, size_t n, size_t stride, bool interleave);
+
     /// Copies x into temp and symmetrically extends edges by filter size.
     ///   e.g. if filter size is 3 and x is:
     ///            1 2 3 4 5 6 7
@@ -32,11 +32,14 @@
 #ifndef WT_1D_LIFT_H
 #define WT_1D_LIFT_H
 
+#include <vector>
 #include "wt_1d.h"
+#include "filter_bank.h"
 
 namespace wavelet {
 
-  /// 1d lifted wavelet transform.  Currently only supports CDF97 wavelets.
+  /// 1d lifted wavelet transform.  Supports the wavelets in filter_t, with lifting
+  /// schemes from lifting.h.  Defaults to CDF97 wavelets.
   ///
   /// Provides implementation of wt_1d_single routines for wt_1d interface.
   /// 
@@ -44,12 +47,18 @@ namespace wavelet {
   ///   http://www.ebi.ac.uk/~gpau/misc/dwt97.c
   class wt_1d_lift : public wt_1d {
   public: 
-    /// Default Constructor
-    wt_1d_lift() { }
+    /// Constructs a lifting transform for the given wavelet.
+    wt_1d_lift(filter_t f = CDF97) : filter(f) { }
     
     /// Destructor
     virtual ~wt_1d_lift() { }
 
+    /// Sets the wavelet to transform with.
+    void set_filter(filter_t f) { filter = f; }
+
+    /// Wavelet this transforms with.
+    filter_t get_filter() const { return filter; }
+
     /// Foward transform for raw contiguous data.
     virtual void fwt_1d_single(double *data, size_t n);
 
@@ -57,6 +66,9 @@ namespace wavelet {
     virtual void iwt_1d_single(double *data, size_t n);
 
   protected:
+    /// Wavelet to transform with.
+    filter_t filter;
+
     /// temporary storage for packing
     std::vector<double> temp;
   }; // wt_1d_lift
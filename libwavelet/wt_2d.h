@@ -51,6 +51,9 @@ namespace wavelet {
     /// transforms for rows and columns.  Returns the number of foward transforms
     /// (levels) that were applied.
     /// completed.
+    /// Dimensions needn't be powers of two.  Each dimension is transformed as many of
+    /// the levels as it is divisible by 2, so a dimension of length n*2^k stops with 
+    /// n approximation coefficients after k levels.
     /// mat:          matrix to perform the forward transform on
     /// level:        level of fwt to apply to them matrix.
     virtual int fwt_2d(wt_matrix& mat, int level = -1);
@@ -88,6 +91,23 @@ namespace wavelet {
     /// col: the column to transform
     /// n:   length of the column, starting at 0, to transform
     virtual void iwt_col(wt_matrix& mat, size_t col, size_t n) = 0;
+
+    /// Forward transform for a group of adjacent matrix columns.  Default
+    /// calls fwt_col() for each column; subclasses can override this to 
+    /// transform several columns at once.
+    /// mat:   a boost matrix containing the data to be transformed
+    /// col:   first column to transform
+    /// count: number of adjacent columns to transform
+    /// n:     length of the columns, starting at 0, to transform
+    virtual void fwt_cols(wt_matrix& mat, size_t col, size_t count, size_t n);
+
+    /// Inverse transform for a group of adjacent matrix columns.  Default
+    /// calls iwt_col() for each column.
+    /// mat:   a boost matrix containing the data to be transformed
+    /// col:   first column to transform
+    /// count: number of adjacent columns to transform
+    /// n:     length of the columns, starting at 0, to transform
+    virtual void iwt_cols(wt_matrix& mat, size_t col, size_t count, size_t n);
   };
 
 
@@ -39,37 +39,75 @@
 
 namespace wavelet { 
 
-  /// This is a lifting implementation of the CDF 9/7 wavelet transform.
-  /// Matrices passed in must be 
-  /// TODO: modify column routines to use groups for speed.
+  /// This is a lifting implementation of the wavelet transform, with the lifting
+  /// schemes in lifting.h.  Defaults to CDF 9/7 wavelets.
+  /// Column transforms are done in tiles of adjacent columns, so that each lifting 
+  /// step walks contiguous memory along rows instead of striding down one column.
+  ///
+  /// By default, fwt_2d() and iwt_2d() work in place: coefficients stay interleaved
+  /// across all levels and are moved into subband order once at the end, instead 
+  /// of being packed after every row and column transform.  Results are the same.
   /// TODO: arbitrarily-sized matrices.
   ///
   /// by Todd Gamblin October 25, 2007.
   ///
   class wt_lift : public wt_2d, public wt_1d_lift {
   public:
-    /// Default Constructor
-    wt_lift();
+    /// Constructs a lifting transform for the given wavelet.
+    wt_lift(filter_t f = CDF97);
     
     /// Destructor
     virtual ~wt_lift();
 
+    /// Set the number of adjacent columns transformed together by fwt_cols() and
+    /// iwt_cols().  A width of 1 transforms columns one at a time with fwt_col()
+    /// and iwt_col().
+    void set_tile_width(size_t width);
+
+    /// Number of adjacent columns transformed together.
+    size_t get_tile_width() const;
+
+    /// Set whether fwt_2d() and iwt_2d() transform in place.  If false, they pack
+    /// rows and columns into subbands at every level, as in wt_2d.
+    void set_in_place(bool in_place);
+
+    /// Whether fwt_2d() and iwt_2d() transform in place.
+    bool get_in_place() const;
+
+    /// Forward 2d transform.  See wt_2d::fwt_2d().
+    virtual int fwt_2d(wt_matrix& mat, int level = -1);
+
+    /// Inverse 2d transform.  See wt_2d::iwt_2d().
+    virtual int iwt_2d(wt_matrix& mat, int fwt_level = -1, int iwt_level = -1);
+
     /// Forward wavelet transform for matrix rows.
-    virtual void fwt_row(wt_matrix& mat, size_t row, size_t n) {
-      fwt_1d_single(&mat(row, 0), n);
-    }
+    virtual void fwt_row(wt_matrix& mat, size_t row, size_t n);
 
     /// Forward wavelet transform for matrix cols
     virtual void fwt_col(wt_matrix& mat, size_t col, size_t n);
 
 
     /// Inverse wavelet transform for matrix rows.
-    virtual void iwt_row(wt_matrix& mat, size_t row, size_t n) {
-      iwt_1d_single(&mat(row, 0), n);
-    }
+    virtual void iwt_row(wt_matrix& mat, size_t row, size_t n);
 
     /// Inverse wavelet transform for matrix cols
     virtual void iwt_col(wt_matrix& mat, size_t col, size_t n);
+
+    /// Forward wavelet transform for adjacent matrix cols, tile_width at a time.
+    virtual void fwt_cols(wt_matrix& mat, size_t col, size_t count, size_t n);
+
+    /// Inverse wavelet transform for adjacent matrix cols, tile_width at a time.
+    virtual void iwt_cols(wt_matrix& mat, size_t col, size_t count, size_t n);
+
+  private:
+    size_t tile_width;   /// Number of adjacent columns to transform together.
+    bool in_place;       /// Whether 2d transforms keep coefficients interleaved until done.
+
+    /// Forward transform of w adjacent columns starting at data, with rows stride apart.
+    void fwt_tile(double *data, size_t stride, size_t w, size_t n);
+
+    /// Inverse transform of w adjacent columns starting at data, with rows stride apart.
+    void iwt_tile(double *data, size_t stride, size_t w, size_t n);
   };
 
 } // namespace 
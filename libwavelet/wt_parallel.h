@@ -36,21 +36,27 @@
 #include <vector>
 #include "wavelet.h"
 #include "wt_direct.h"
+#include "Timer.h"
 
 /// This is a parallel implementation of the cdf wavelet transform.
 /// This is based on the algorithm described in Nielsen, 2000.
 /// TODO: arbitrarily-sized matrices.
-/// TODO: make this hierarchical so it can do arbitrary transform levels, 
-///       instead of just as far as you can go w/the local data size.
 namespace wavelet { 
 
-  class wt_parallel : private wt_1d_direct {
+  /// The transform is templated on the type of matrix elements.  wt_parallel transforms
+  /// doubles, and wt_parallel_f transforms floats, with half the memory traffic and 
+  /// half the data in exchanges.  Both are instantiated in wt_parallel.C.
+  template <class T>
+  class basic_wt_parallel : private wt_1d_direct {
   public:
+    /// Type of matrices this transforms.
+    typedef boost::numeric::ublas::matrix<T> matrix_type;
+
     /// Constructor -- just delegates to wt_direct.
-    wt_parallel(filter_bank& f = filter::getCDF97());
+    basic_wt_parallel(filter_bank& f = filter::getCDF97());
 
     /// Destructor
-    virtual ~wt_parallel();
+    virtual ~basic_wt_parallel();
 
     /// Forward transform for matrix.  
     /// This is a collective operation -- all processes in the communicator
@@ -69,25 +75,40 @@ namespace wavelet {
     /// mat:   a boost matrix containing the data to be transformed
     /// level: number of level iterations to perform
     ///        must be <= log2(min(mat.size1(), mat.size2())
+    ///        If negative, this goes as far as nearest-neighbor exchange allows,
+    ///        or, in hierarchical mode, to the full level.
     ///
     /// Returns the level of the transform performed.  This may be less than
     /// the level provided, depending on the data's layout 
-    int fwt_2d(wt_matrix& mat, int level = -1, MPI_Comm comm = MPI_COMM_WORLD);
+    int fwt_2d(matrix_type& mat, int level = -1, MPI_Comm comm = MPI_COMM_WORLD);
 
 
-    
-    int iwt_2d(wt_matrix& mat, int level = -1, MPI_Comm comm = MPI_COMM_WORLD);
+    /// Inverse transform for matrix.  Parameters are as for fwt_2d, and level
+    /// should be the level returned by fwt_2d.
+    int iwt_2d(matrix_type& mat, int level = -1, MPI_Comm comm = MPI_COMM_WORLD);
+
+
+    /// Set whether transforms are hierarchical.  Once local data gets too small for
+    /// nearest-neighbor exchange, a hierarchical fwt_2d() gathers the low-frequency
+    /// subband onto half as many processes and keeps transforming there, halving 
+    /// again as needed until the full level is reached.  iwt_2d() scatters it back.
+    /// Output is distributed just as for non-hierarchical transforms, so the full 
+    /// level is the number of times both mat.size1() and mat.size2() are divisible
+    /// by 2, and process count must be a power of two to get there.
+    void set_hierarchical(bool hierarchical);
+
+    /// Whether transforms are hierarchical.
+    bool get_hierarchical() const;
 
 
     /// Use this function to gather distributed data onto fewer processors.
     /// Use with MPI_Comm_split to perform a number of wavelet transforms 
     /// in parallel.
-    /// Given a vector of local data
-    /// PRE:  local size is a power of two
-    ///       system size is power of two
+    /// Given n values of local data, which are sent without being copied
+    /// PRE:  m evenly divides system size
     /// POST: Data in local is aggregated into mat on all processors where 
     ///       (size % m == set)
-    static void aggregate(wt_matrix& mat, std::vector<double>& local, 
+    static void aggregate(matrix_type& mat, T *local, size_t n,
 			  int m, int set, 
 			  std::vector<MPI_Request>& reqs, 
 			  MPI_Comm comm = MPI_COMM_WORLD);
@@ -95,55 +116,95 @@ namespace wavelet {
     /// Inverse of aggregate().
     /// 
     /// Given a matrix full of wavelet data:
-    /// PRE:  local size is a power of two, local.size() == mat.size2()
-    ///       system size is power of two
+    /// PRE:  local has room for n == mat.size2() values
+    ///       m evenly divides system size
     /// POST: Rows of matrix are distributed to all processors where
     ///       (size % m == set)
-    static void distribute(wt_matrix& mat, std::vector<double>& local, 
+    static void distribute(matrix_type& mat, T *local, size_t n,
 			  int m, int set, 
 			  std::vector<MPI_Request>& reqs, 
 			  MPI_Comm comm = MPI_COMM_WORLD);
     
 
     /// Gathers all pieces of a distributed matrix together into a local matrix.
-    static void gather(wt_matrix& dest, wt_matrix& mat, 
+    static void gather(matrix_type& dest, matrix_type& mat, 
 		       MPI_Comm comm, int root = 0);
 
     /// Scatters per-process chunks of a matrix out to all members of comm.
-    static void scatter(wt_matrix& dest, wt_matrix& mat, 
+    static void scatter(matrix_type& dest, matrix_type& mat, 
 		       MPI_Comm comm, int root = 0);
 
 
+    /// Timings for the last call to fwt_2d() or iwt_2d().  Column computation that
+    /// overlaps the neighbor exchange is recorded as WTOverlap, and time spent 
+    /// blocked on the exchange as WTExchangeWait.  Gathering and scattering for
+    /// hierarchical transforms is recorded as WTHierarchy.
+    const Timer& get_timer() { return timer; }
+
+
     /// Puts a matrix back together after a parallel wavelet transform with fwt_2d.
     /// This just rearranges the rows so that they're in the order we're used to.
     /// This algorithm is O(M*N) for an M row by N column matrix.
     /// POST: mat's elements have been rearranged to the standard wavelet transform order.
-    static void reassemble(wt_matrix& mat, int P, int level);
+    static void reassemble(matrix_type& mat, int P, int level);
 
 
   protected:
     /// Wrapper around wt_1d_direct method that knows about matrix.
-    void fwt_row(wt_matrix& mat, size_t row, size_t n) {
-      fwt_1d_single(&mat(row, 0), n);
+    void fwt_row(matrix_type& mat, size_t row, size_t n) {
+      fwt_single(&mat(row, 0), n, row_temp);
     }
 
     /// Wrapper around wt_1d_direct method that knows about matrix.
-    void iwt_row(wt_matrix& mat, size_t row, size_t n) {
-      iwt_1d_single(&mat(row, 0), n);
+    void iwt_row(matrix_type& mat, size_t row, size_t n) {
+      iwt_single(&mat(row, 0), n, row_temp);
     }
 
-    /// Parallel column transform.  Requires that data be preconditioned by 
-    void fwt_col(wt_matrix& mat, size_t col, size_t n);
+    /// Parallel column transform for output rows [begin, end) of each half of the
+    /// first n rows and cols columns of local.  Requires that data be preconditioned 
+    /// by build_ext(), and by extend_ext() for outputs near the boundaries.
+    void fwt_ext(matrix_type& local, size_t n, size_t cols, size_t begin, size_t end);
 
-    /// Parallel column transform.  Requires that data be preconditioned by 
-    void iwt_col(wt_matrix& mat, size_t col, size_t n);
+    /// Parallel inverse column transform for output rows [begin, end) of local.
+    /// Requires that data be preconditioned by build_ext() with interleave set, and 
+    /// by extend_ext() for outputs near the boundaries.
+    void iwt_ext(matrix_type& local, size_t cols, size_t begin, size_t end);
     
   private:
-    /// Copies one column of local and remote data into temporary array: left 
-    /// first, then local, then right.  If this process has no left or right neighbor
-    /// then the local data is extended symmetrically to the appropriate side(s).
-    void build_temp(wt_matrix& left, wt_matrix& local, wt_matrix& right, 
-		    size_t rows, size_t col, int rank, int comm_size, bool interleave = false);
+    bool hierarchical;      /// Whether to gather onto fewer processes to finish transforms.
+    matrix_type ext;        /// Local rows, extended with rows from neighbors, for column transforms.
+    matrix_type send_left;  /// Copies of rows being sent to the left neighbor.
+    matrix_type send_right; /// Copies of rows being sent to the right neighbor.
+    std::vector<T> row_temp;  /// Temporary storage for row transforms.
+    Timer timer;            /// Timings for the last transform.
+
+    /// Number of levels that can be done on rows local rows with only nearest-neighbor 
+    /// exchange.
+    int neighbor_levels(size_t rows);
+
+    /// Level that a hierarchical transform will reach on size processes with rows x cols
+    /// local data, if asked for level levels.  This is less than level if size isn't
+    /// a power of two.
+    int hierarchy_level(size_t rows, size_t cols, int size, int level);
+
+    /// Does levels [done, level) of a hierarchical forward transform by gathering the 
+    /// low-frequency subband of local onto even ranks of comm, transforming it on a 
+    /// communicator of half the size, and splitting the result back.
+    void fwt_hierarchy(matrix_type& local, int done, int level, MPI_Comm comm);
+
+    /// Inverse of fwt_hierarchy().
+    void iwt_hierarchy(matrix_type& local, int done, int level, MPI_Comm comm);
+
+    /// Copies the first rows x cols of local into the middle of ext, leaving room 
+    /// for rows from neighbors on either side.  This doesn't depend on the exchange,
+    /// so it can be done while the exchange is in flight.
+    void build_ext(matrix_type& local, size_t rows, size_t cols, bool interleave = false);
+
+    /// Fills in the borders of ext with rows from left and right neighbors.  If this 
+    /// process has no left or right neighbor then the local data is extended 
+    /// symmetrically to the appropriate side(s).
+    void extend_ext(matrix_type& left, matrix_type& right, 
+                    size_t rows, size_t cols, int rank, int comm_size);
 
 
     /// This routine handles data exchange between neighbors in the parallel wavelet transform.
@@ -166,17 +227,20 @@ namespace wavelet {
     /// cols:  number of cols in local data still being transformed.
     /// reqs:  All requests issued here are appended to this vector.
     /// comm:  Communicator on which transform is being performed.
-    void fwt_exchange(wt_matrix& left, wt_matrix& local, wt_matrix& right, 
+    void fwt_exchange(matrix_type& left, matrix_type& local, matrix_type& right, 
 		      size_t rows, size_t cols, std::vector<MPI_Request>& reqs, 
 		      MPI_Comm comm);
 
 
     /// This routine handles data exchange for the inverse wavelet transform.  Parameters
     /// are as for fwt_exchange, but data laout is slightly different.
-    void iwt_exchange(wt_matrix& left, wt_matrix& local, wt_matrix& right, 
+    void iwt_exchange(matrix_type& left, matrix_type& local, matrix_type& right, 
 		      size_t rows, size_t cols, std::vector<MPI_Request>& reqs, 
 		      MPI_Comm comm);
   };
+
+  typedef basic_wt_parallel<double> wt_parallel;
+  typedef basic_wt_parallel<float>  wt_parallel_f;
   
 } // namespace 
 
@@ -0,0 +1,72 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC.  
+// Produced at the Lawrence Livermore National Laboratory  
+// Written by Todd Gamblin, tgamblin@llnl.gov.
+// LLNL-CODE-417602
+// All rights reserved.  
+// 
+// This file is part of Libra. For details, see http://github.com/tgamblin/libra.
+// Please also read the LICENSE file for further information.
+// 
+// Redistribution and use in source and binary forms, with or without modification, are
+// permitted provided that the following conditions are met:
+// 
+//  * Redistributions of source code must retain the above copyright notice, this list of
+//    conditions and the disclaimer below.
+//  * Redistributions in binary form must reproduce the above copyright notice, this list of
+//    conditions and the disclaimer (as noted below) in the documentation and/or other materials
+//    provided with the distribution.
+//  * Neither the name of the LLNS/LLNL nor the names of its contributors may be used to endorse
+//    or promote products derived from this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+// OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+// LAWRENCE LIVERMORE NATIONAL SECURITY, LLC, THE U.S. DEPARTMENT OF ENERGY OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+// ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+/////////////////////////////////////////////////////////////////////////////////////////////////
+#ifndef WT_REVERSIBLE_H
+#define WT_REVERSIBLE_H
+
+#include <vector>
+#include "wavelet.h"
+
+namespace wavelet {
+
+  /// Reversible integer-to-integer LeGall 5/3 transform (see lifting::lift_int53()) for
+  /// lossless coding.  This works in place on quantized data, and leaves coefficients in
+  /// the same subband order as wt_2d.  Coefficients aren't normalized, so approximation
+  /// coefficients stay about the size of the data.  Levels work as they do for wt_2d.
+  class wt_reversible {
+  public:
+    /// Constructor
+    wt_reversible();
+
+    /// Destructor
+    ~wt_reversible();
+
+    /// Forward transform.  Returns the level of the transform done.
+    int fwt_2d(quantized_matrix& mat, int level = -1);
+
+    /// Inverse transform.  Exactly undoes fwt_2d() if iwt_level is fwt_level.
+    /// Returns the number of levels inverted.
+    int iwt_2d(quantized_matrix& mat, int fwt_level = -1, int iwt_level = -1);
+
+  private:
+    std::vector<quantized_t> temp;   /// temporary storage for packing
+
+    /// Moves even elements of the n elements stride apart at data to the first half, 
+    /// and odd elements to the second.
+    void pack(quantized_t *data, size_t stride, size_t n);
+
+    /// Inverse of pack().
+    void unpack(quantized_t *data, size_t stride, size_t n);
+  };
+
+} // namespace
+
+#endif // WT_REVERSIBLE_H
@@ -103,6 +103,22 @@ namespace wavelet {
     return (bits >> 3) + ((bits & 0x7l) ? 1 : 0);
   }
 
+  /// Reads the 8 bytes at buf as a big-endian 64-bit word, so that the first bit in 
+  /// buf is the high bit of the word.
+  inline uint64_t read_word(const unsigned char *buf) {
+    uint64_t word = 0;
+    for (int i=0; i < 8; i++) word = (word << 8) | buf[i];
+    return word;
+  }
+
+  /// Writes word to the 8 bytes at buf, high byte first.  Inverse of read_word().
+  inline void write_word(unsigned char *buf, uint64_t word) {
+    for (int i=7; i >= 0; i--) {
+      buf[i] = (unsigned char)word;
+      word >>= 8;
+    }
+  }
+
   
   /// Inserts bits from src into dest at an offset.  
   /// Params:
@@ -121,6 +137,8 @@ namespace wavelet {
   /// copy_bits:    number of bits from src to append.
   /// dest_offset:  offset (in bits) into destination buffer to start writing
   /// src_offset:   offset (in bits) into src buffer to start reading
+  /// Bits in dest before dest_offset are kept, and bits after the copied ones in the 
+  /// last byte written are zeroed.  Long copies are shifted in 64-bit words.
   void insert_bits(unsigned char *dest, const unsigned char *src, long copy_bits, 
 		   long dest_offset, long src_offset);
 